@@ -1,19 +1,22 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <compression/bitmap.hpp>
+#include <compression/roaring_bitmap.hpp>
+#include <compression/bit_packed_vector.hpp>
 #include <vector>
-#include <bitset>
+#include <algorithm>
+#include <boost/unordered_map.hpp>
 
 namespace CoGaDB{
 
 
 	/*
 	
-	To really access just one bit we created the BitVector class,
-	because the std::bitset is not serializeable.
-	It uses the std::vector<unsigned char>. So for each element in the
-	vector we get 8 bits to set.
-	If we need more, another unsigned char is added.
+	A BitVector holds the bitmap of one value of the column: bit i is set
+	if the row at bit position i has this value. The bitmap is compressed
+	(see RoaringBitmap), so a rare value only costs memory for the rows it
+	appears in, not for the whole column length.
 
 	The T value is the value in the column.
 	
@@ -22,76 +25,65 @@ namespace CoGaDB{
 	class BitVector {
 	private:
 		T value;
-		std::vector<unsigned char> bitvector;
+		RoaringBitmap bitmap;
 	public:
-		BitVector() {} //just for serialization
+		BitVector() : value(), bitmap() {} //just for serialization
 
-		BitVector(T value, unsigned int size) { //Creating a vector with size in bits
-			size = size % 8 == 0 ? size / 8 : size / 8 + 1;
-			for (unsigned int i = 0; i < size; i++) {
-				this->bitvector.push_back(0);
-			}
-			this->value = value;
+		explicit BitVector(T value) : value(value), bitmap() { //Creating an empty vector
 		}
-		BitVector(T value, std::string vector) { //Creating a vector from (literally) a bitstring
+		BitVector(T value, std::string vector) : value(value), bitmap() { //Creating a vector from (literally) a bitstring
 			for (unsigned int i = 0; i < vector.size(); i++) {
-				if (i % 8 == 0)
-					this->bitvector.push_back(0);
 				if (vector[i]=='1')
-					(this->bitvector[i / 8]) |= (1 << (i % 8));
+					this->bitmap.set(i);
 			}
-			this->value = value;
 		}
-		~BitVector() {  }
 
 		//Set one position to one
 		void to_one(unsigned int position) {
-			(this->bitvector[position / 8]) |= (1 << (position % 8));
+			this->bitmap.set(position);
 		}
 
 		//Set one position to zero
 		void to_zero(unsigned int position) {
-			(this->bitvector[position / 8]) &= ~(1 << (position % 8));
+			this->bitmap.reset(position);
 		}
 
 		unsigned int at(unsigned int position) const {
-			if ((((this->bitvector[position / 8]) >> (position % 8)) & 1) == 1)
-				return 1;
-			return 0;
+			return this->bitmap.test(position) ? 1 : 0;
 		}
 
-		//check if a byte in the vector is zero
-		bool isZero(unsigned int byte) {
-			return this->bitvector[byte] == 0;
+		boost::uint64_t word(unsigned int word) const {
+			return this->bitmap.word(word);
 		}
 
-		//check whether the entire vector is zero
-		bool isZero() {
-			for (unsigned int i = 0; i < this->bitvector.size(); i++) {
-				if (this->bitvector[i] != 0)
-					return false;
-			}
-			return true;
+		//check if a word in the vector is zero
+		bool isZero(unsigned int word) const {
+			return this->bitmap.isZero(word);
 		}
 
-		void addByte() {
-			this->bitvector.push_back(0);
+		//check whether the entire vector is zero
+		bool isZero() const {
+			return this->bitmap.isZero();
 		}
 
-		void removeByte(unsigned int byte) {
-			this->bitvector.erase(this->bitvector.begin()+byte);
+		//calls visitor(position) for every set bit in ascending order
+		template<typename Visitor>
+		void visit(Visitor& visitor) const {
+			this->bitmap.visit(visitor);
 		}
 
-		unsigned int size() const{ //size in byte
-			return this->bitvector.size();
+		const RoaringBitmap& getBitmap() const { return this->bitmap; }
+
+		unsigned int getSizeinBytes() const {
+			return this->bitmap.getSizeinBytes();
 		}
 
 		T getValue() const { return this->value; }
 		T& getValueRef()  { return this->value; }
 
-		std::string bitstring() const {
+		std::string bitstring(unsigned int length) const {
 			std::string res = "";
-			for (unsigned int i = 0; i < this->bitvector.size()*8; i++){
+			for (unsigned int i = 0; i < length; i++){
 				if (this->at(i) == 1)
 					res += "1";
 				else
@@ -104,7 +96,7 @@ namespace CoGaDB{
 		template<class Archive>
 		void serialize(Archive & ar, const unsigned int version)
 		{
-			ar & this->bitvector;
+			ar & this->bitmap;
 			ar & this->value;
 		}
 	};
@@ -138,6 +130,21 @@ namespace CoGaDB{
 		virtual bool load(const std::string& path);
 
 		virtual T& operator[](const int index);
+		virtual void decode(TID begin, TID end, T* out);
+
+		virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+		virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+		virtual const PositionListPtr sort(SortOrder order);
+
+		/*! \brief returns the TIDs of all rows, which fulfill the filter condition, as a bitmap
+		 *  \details the results of several columns can be combined with AND/OR (see RoaringBitmap)
+		 *  before they are converted with RoaringBitmap::toPositionList()*/
+		RoaringBitmap selectionBitmap(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads = 1);
+
+		//closes the gaps of removed rows in the bitmaps
+		void compact();
+		//returns the number of bit positions of removed rows, which compact() reclaims
+		unsigned int getNumberOfUnusedPositions() const throw();
 
 		//serialize for easier load and store
 		template<class Archive>
@@ -145,96 +152,219 @@ namespace CoGaDB{
 		{
 			ar & this->values;
 			ar & this->column_length;
-			ar & this->bytes;
+			ar & this->words;
 			ar & this->elem_num;
+			ar & this->validity;
 		}
 
 
 	private:
+		/*
+
+		'column_length' is the number of bit positions in use, 'words' the
+		number of 64 bit words of the validity bitmap. A bit position holds a
+		row if its bit is set in 'validity', the TID of the row is the rank of
+		its bit position there. A removed row only clears its bits, so it is
+		hidden from all reads, until compact() closes the gaps. So a TID is mapped to its bit position with
+		validity.select(tid).
+
+		'value_indexes' holds for every bit position the index of the bit
+		vector, whose bit is set there (bit packed, log2(d) bits per
+		position). So the value of a TID is found in constant time after the
+		select, independent of the number of distinct values. The index of
+		a removed position is stale until the next compaction, but never
+		read. It is not serialized, but rebuilt after loading.
+
+		'directory' maps each value to the index of its bit vector. The order
+		of the bit vectors does not matter, so an erased bit vector is
+		replaced by the last one and only one index changes. The directory
+		is not serialized, but rebuilt after loading.
+
+		*/
 		std::vector<BitVector<T>> values;
 		unsigned int column_length;
-		unsigned int bytes;
+		unsigned int words;
 		unsigned int elem_num;
+		RankSelectBitmap validity;
+		BitPackedVector value_indexes;
+		boost::unordered_map<T, unsigned int> directory;
+
+		//Search for a certain value, if found -> index is returned, otherwise -1
+		int lookup(const T& value) const {
+			typename boost::unordered_map<T, unsigned int>::const_iterator it = this->directory.find(value);
+			if (it == this->directory.end())
+				return -1;
+			return it->second;
+		}
+
+		//adds an empty bit vector for a new value and returns its index
+		unsigned int addValue(const T& value) {
+			this->values.push_back(BitVector<T>(value));
+			this->directory[value] = this->values.size() - 1;
+			return this->values.size() - 1;
+		}
 
-		//Search for a certain value, if found -> index is returned
-		unsigned int lookup(T value) {
-			for (unsigned int i = 0; i < this->values.size(); i++) {
-				if (this->values[i].getValue() == value)
-					return i;
+		//erases the bit vector of a value, the last bit vector takes its place
+		void eraseValue(unsigned int index) {
+			this->directory.erase(this->values[index].getValue());
+			if (index + 1 != this->values.size()) {
+				std::swap(this->values[index], this->values.back());
+				this->directory[this->values[index].getValue()] = index;
+				IndexVisitor visitor(this->value_indexes, index);
+				this->values[index].visit(visitor);
 			}
-			return -1;
+			this->values.pop_back();
 		}
 
-		void extend_vectors() {
-			for (unsigned int i = 0; i < this->values.size(); i++) {
-				this->values[i].addByte();
+		//writes the index of a bit vector to the value index of its set bits
+		struct IndexVisitor {
+			BitPackedVector& value_indexes;
+			const unsigned int index;
+			IndexVisitor(BitPackedVector& value_indexes_, unsigned int index_) : value_indexes(value_indexes_), index(index_) {}
+			void operator() (unsigned int bitpos) { value_indexes.set(bitpos, index); }
+		};
+
+		//recomputes the value index of every bit position from the bit vectors
+		void rebuildValueIndexes() {
+			this->value_indexes.clear();
+			for (unsigned int i = 0; i < this->column_length; i++)
+				this->value_indexes.push_back(0);
+			for (unsigned int j = 0; j < this->values.size(); j++) {
+				IndexVisitor visitor(this->value_indexes, j);
+				this->values[j].visit(visitor);
 			}
-			this->bytes++;
+		}
+
+		void rebuildDirectory() {
+			this->directory.clear();
+			for (unsigned int i = 0; i < this->values.size(); i++)
+				this->directory[this->values[i].getValue()] = i;
+		}
+
+		//the value bitmaps grow on their own, only the validity bitmap needs another word
+		void extend_vectors() {
+			this->validity.addWord();
+			this->words++;
+		}
+
+		//returns the index of the bit vector of a row, -1 if there is no such row
+		int valueIndexByTID(TID tid) const {
+			if (tid < this->elem_num)
+				return (int)this->value_indexes.get(this->validity.select(tid));
+			return -1;
 		}
 
 		// This function retunes T at position tid
 		T getByTID(TID tid) const{
-			int index = 0;
-			for (unsigned int i = 0; i < this->column_length; i++) {
-				for (unsigned int j = 0; j < this->values.size(); j++) {
-					if (this->values[j].at(i) == 1) {
-						if (index == tid)
-							return this->values[j].getValue();
-					
-						index++;
-						break;
-					}
-				}
-			}
+			const int index = this->valueIndexByTID(tid);
+			if (index != -1)
+				return this->values[index].getValue();
 			return T();
 		}
 
 		//Calculates the position in the vector by tid
-		// tid != pos. in vector because we cannot remove a single bit from a byte
-		int bitPosByTID(TID tid) {
-			unsigned int index = 0;
-			if (tid < this->elem_num) {
-				for (unsigned int i = 0; i < this->column_length; i++) {
-					for (unsigned int j = 0; j < this->values.size(); j++) {
-						if (this->values[j].at(i) == 1) {
-							if (index == tid)
-								return i;
-
-							index++;
-							break;
-						}
-					}
-				}
-			}
+		// tid != pos. in vector because we cannot remove a single bit from a word
+		int bitPosByTID(TID tid) const {
+			if (tid < this->elem_num)
+				return this->validity.select(tid);
 			return -1;
 		}
 
-		//If a block (byte) is clear (zero) in all bitvectors of all values
-		//we can simply remove it, because it holds no information.
-		//The byte is the smallest data structure we can remove.
-		void clearZeroBytes() {
-			bool zero;
-			for (unsigned int i = 0; i < this->bytes; i++) {
-				zero = true;
-				for (unsigned int j = 0; j < this->values.size(); j++) {
-					if (this->values[j].isZero(i) == false)
-						zero = false;
-				}
-				if (zero) {
-					for (unsigned int k = 0; k < this->values.size(); k++)
-						this->values[k].removeByte(i);
-					this->column_length -= 8;
-					this->bytes--;
-				}
+		//copies the set bits of a bitmap to their new positions (removed rows have a negative one), see remove(PositionListPtr)
+		struct MoveVisitor {
+			const std::vector<int>& new_pos;
+			BitVector<T>& target;
+			MoveVisitor(const std::vector<int>& new_pos_, BitVector<T>& target_) : new_pos(new_pos_), target(target_) {}
+			void operator() (unsigned int bitpos) {
+				if (new_pos[bitpos] >= 0)
+					target.to_one(new_pos[bitpos]);
 			}
+		};
+
+		static bool qualifies(const T& row_value, const T& value, const ValueComparator comp) {
+			if (comp == EQUAL)
+				return row_value == value;
+			if (comp == LESSER)
+				return row_value < value;
+			if (comp == GREATER)
+				return row_value > value;
+			return false;
+		}
+
+		//ORs the bitmaps of all values in values[first, last), which fulfill the filter condition
+		void orBitmaps(const T& value, const ValueComparator comp, unsigned int first, unsigned int last, RoaringBitmap& result) const {
+			for (unsigned int j = first; j < last; j++) {
+				if (qualifies(this->values[j].getValue(), value, comp))
+					result |= this->values[j].getBitmap();
+			}
+		}
+
+		//ORs the qualifying bitmaps of one of partial_results.size() contiguous ranges of values, a morsel of selectionBitmap()
+		struct OrChunk {
+			const BitVectorCompressedColumn<T>& column;
+			const T& value;
+			const ValueComparator comp;
+			std::vector<RoaringBitmap>& partial_results;
+			OrChunk(const BitVectorCompressedColumn<T>& column_, const T& value_, ValueComparator comp_, std::vector<RoaringBitmap>& partial_results_)
+				: column(column_), value(value_), comp(comp_), partial_results(partial_results_) {}
+			void operator()(unsigned int chunk) const {
+				const size_t values = column.values.size(), chunks = partial_results.size();
+				column.orBitmaps(value, comp, (unsigned int)(values * chunk / chunks), (unsigned int)(values * (chunk + 1) / chunks), partial_results[chunk]);
+			}
+		};
+
+		//sets the TID of every bit position
+		struct TIDVisitor {
+			const RankSelectBitmap& validity;
+			RoaringBitmap& tids;
+			TIDVisitor(const RankSelectBitmap& validity_, RoaringBitmap& tids_) : validity(validity_), tids(tids_) {}
+			void operator() (unsigned int bitpos) { tids.set(validity.rank(bitpos)); }
+		};
+
+		//appends the TID of every bit position to a list
+		struct AppendTIDVisitor {
+			const RankSelectBitmap& validity;
+			const bool gaps;
+			PositionList& tids;
+			AppendTIDVisitor(const RankSelectBitmap& validity_, bool gaps_, PositionList& tids_) : validity(validity_), gaps(gaps_), tids(tids_) {}
+			void operator() (unsigned int bitpos) { tids.push_back(gaps ? validity.rank(bitpos) : bitpos); }
+		};
+
+		//compares two bitmaps by their values
+		struct BitmapOrder {
+			const std::vector<BitVector<T> >& values;
+			const bool descending;
+			BitmapOrder(const std::vector<BitVector<T> >& values_, bool descending_) : values(values_), descending(descending_) {}
+			inline bool operator() (unsigned int i, unsigned int j) const {
+				return descending ? values[j].getValue() < values[i].getValue() : values[i].getValue() < values[j].getValue();
+			}
+		};
+
+		//translates bit positions to TIDs, they are the same as long as no position is unused
+		RoaringBitmap toTIDs(const RoaringBitmap& positions) const {
+			if (this->column_length == this->elem_num)
+				return positions;
+			RoaringBitmap tids;
+			TIDVisitor visitor(this->validity, tids);
+			positions.visit(visitor);
+			return tids;
+		}
+
+		//renumbers the bit positions of all rows, which are not in the (sorted) list of removed TIDs
+		void rebuild(const PositionList& removed_tids);
+
+		//Removed rows only clear their bits, the unused bit positions are
+		//reclaimed once they make up more than half of the column.
+		void compactIfNeeded() {
+			const unsigned int unused = this->column_length - this->elem_num;
+			if (unused > 4096 && unused > this->column_length / 2)
+				this->compact();
 		}
 	};
 
 	template<class T>
-	BitVectorCompressedColumn<T>::BitVectorCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type){
-		column_length = 0;
-		bytes = 0;
-		elem_num = 0;
+	BitVectorCompressedColumn<T>::BitVectorCompressedColumn(const std::string& name, AttributeType db_type) : CompressedColumn<T>(name, db_type),
+		values(), column_length(0), words(0), elem_num(0), validity(), value_indexes(), directory(){
 	}
 
 	template<class T>
@@ -257,15 +387,14 @@ namespace CoGaDB{
 	bool BitVectorCompressedColumn<T>::insert(const T& new_value){
 		int index = this->lookup(new_value); //Search for new value
 
-		if (this->column_length / 8 >= bytes) //vector is full ?
+		if (this->column_length / 64 >= this->words) //vector is full ?
 			this->extend_vectors();
 
-		if (index != -1) // New value exists 
-			this->values[index].to_one(this->column_length);
-		else {
-			this->values.push_back(BitVector<T>(new_value, this->bytes*8)); //add new value if it exists not
-			this->values.back().to_one(this->column_length);
-		}
+		if (index == -1) // add new value if it exists not
+			index = this->addValue(new_value);
+		this->values[index].to_one(this->column_length);
+		this->validity.set(this->column_length);
+		this->value_indexes.push_back(index);
 
 		this->column_length++;
 		this->elem_num++;
@@ -295,7 +424,7 @@ namespace CoGaDB{
 	void BitVectorCompressedColumn<T>::print() const throw(){
 		std::cout << "   Bit Vectors\n" << "_________________________\n";
 		for (unsigned int i = 0; i < this->values.size(); i++) {
-			std::cout << this->values[i].getValue() << "\t" << this->values[i].bitstring() << std::endl;
+			std::cout << this->values[i].getValue() << "\t" << this->values[i].bitstring(this->column_length) << std::endl;
 		}
 		std::cout << "\n   Column\n" << "_________________________\n";
 		for (unsigned int i = 0; i < this->elem_num; i++) {
@@ -317,9 +446,10 @@ namespace CoGaDB{
 	bool BitVectorCompressedColumn<T>::update(TID tid, const boost::any& obj){
 		if (!obj.empty() && typeid(T) == obj.type() && tid < this->elem_num) {
 
-			if (this->lookup(boost::any_cast<T>(obj)) == -1) //if new value does not exist -> add it
-				this->values.push_back(BitVector<T>(boost::any_cast<T>(obj), this->bytes * 8));
-
+			const T& value = boost::any_cast<const T&>(obj);
+			int new_value_pos = this->lookup(value);
+			if (new_value_pos == -1) //if new value does not exist -> add it
+				new_value_pos = this->addValue(value);
 
 			/*
 			First we calculate the bitposition and the respective position
@@ -328,20 +458,20 @@ namespace CoGaDB{
 
 			*/
 
-			int new_value_pos = this->lookup(boost::any_cast<T>(obj));
 			unsigned int bitpos = this->bitPosByTID(tid);
-			unsigned int old_value_pos = this->lookup(this->getByTID(tid));
-				
+			int old_value_pos = this->value_indexes.get(bitpos);
+			if (old_value_pos == new_value_pos)
+				return true;
+
 			this->values[old_value_pos].to_zero(bitpos);
 			this->values[new_value_pos].to_one(bitpos);
+			this->value_indexes.set(bitpos, new_value_pos);
 
 			//If the old values bit vector is zero->it doesn't appear in the
 			//column.So we can delete it.
 
 			if (this->values[old_value_pos].isZero())
-				this->values.erase(this->values.begin() + old_value_pos);
-
-			this->clearZeroBytes(); // check "empty" parts in the vectors
+				this->eraseValue(old_value_pos);
 
 			return true;
 		}
@@ -360,15 +490,17 @@ namespace CoGaDB{
 	template<class T>
 	bool BitVectorCompressedColumn<T>::remove(TID tid){
 		if (tid < this->elem_num) {
-			unsigned int value_pos = this->lookup(this->getByTID(tid)); //Where is the position of the value to be deleted?
+			unsigned int bitpos = this->bitPosByTID(tid);
+			unsigned int value_pos = this->value_indexes.get(bitpos); //Where is the position of the value to be deleted?
 
-			this->values[value_pos].to_zero(this->bitPosByTID(tid)); //delete value by setting the bit to 0
+			this->values[value_pos].to_zero(bitpos); //delete value by setting the bit to 0
+			this->validity.reset(bitpos);
 			this->elem_num--;
 
 			if (this->values[value_pos].isZero()) //Delete value when it never appears in the column
-				this->values.erase(this->values.begin() + value_pos);
+				this->eraseValue(value_pos);
 
-			this->clearZeroBytes();// check "empty" parts in the vectors
+			this->compactIfNeeded();
 
 			return true;
 		}
@@ -377,19 +509,89 @@ namespace CoGaDB{
 
 	template<class T>
 	bool BitVectorCompressedColumn<T>::remove(PositionListPtr posPtr){
-		for (unsigned int i = 0; i < posPtr->size(); i++)
-		if (!this->remove(posPtr->at(i)))
+		if (!posPtr)
+			return false;
+		//an empty TID list is an error, like in Column<T>::remove()
+		if (posPtr->empty())
+			return false;
+
+		PositionListPtr tids = sortedPositionList(posPtr);
+		if (tids->back() >= this->elem_num)
 			return false;
 
+		this->rebuild(*tids);
 		return true;
 	}
 
+	template<class T>
+	void BitVectorCompressedColumn<T>::compact(){
+		if (this->column_length != this->elem_num)
+			this->rebuild(PositionList());
+	}
 
+	template<class T>
+	unsigned int BitVectorCompressedColumn<T>::getNumberOfUnusedPositions() const throw(){
+		return this->column_length - this->elem_num;
+	}
+
+	/*
+	All bit vectors are rebuilt once without the removed rows:
+	1. One sweep over the set bits of the validity bitmap assigns the new
+	   bit position of every row that is kept (the gaps of earlier
+	   deletions are closed as well).
+	2. Each bit vector is copied to its new positions, values that do not
+	   appear any more are dropped.
+	*/
+	template<class T>
+	void BitVectorCompressedColumn<T>::rebuild(const PositionList& tids){
+		const int REMOVED = -1;
+		std::vector<int> new_pos(this->column_length, REMOVED);
+		unsigned int tid = 0, kept = 0, k = 0;
+		for (unsigned int w = 0; w < this->words; w++) {
+			for (boost::uint64_t bits = this->validity.word(w); bits != 0; bits &= bits - 1) {
+				const unsigned int i = w * 64 + countTrailingZeros64(bits);
+				if (k < tids.size() && tids[k] == tid) {
+					while (k < tids.size() && tids[k] == tid) //skip duplicate TIDs
+						k++;
+				}
+				else
+					new_pos[i] = kept++;
+				tid++;
+			}
+		}
+
+		std::vector<BitVector<T>> values;
+		for (unsigned int j = 0; j < this->values.size(); j++) {
+			BitVector<T> bitvector(this->values[j].getValue());
+			MoveVisitor visitor(new_pos, bitvector);
+			this->values[j].visit(visitor);
+			if (!bitvector.isZero())
+				values.push_back(bitvector);
+		}
+
+		//the kept rows occupy the positions [0, kept)
+		this->validity.clear();
+		for (unsigned int i = 0; i < kept; i++) {
+			if (i % 64 == 0)
+				this->validity.addWord();
+			this->validity.set(i);
+		}
+
+		this->values.swap(values);
+		this->rebuildDirectory();
+		this->column_length = kept;
+		this->words = (kept + 63) / 64;
+		this->elem_num = kept;
+		this->rebuildValueIndexes();
+	}
 
 	template<class T>
 	bool BitVectorCompressedColumn<T>::clearContent(){
 		this->values.clear();
-		this->bytes = 0;
+		this->directory.clear();
+		this->validity.clear();
+		this->value_indexes.clear();
+		this->words = 0;
 		this->column_length = 0;
 		this->elem_num = 0;
 		return true;
@@ -418,6 +620,8 @@ namespace CoGaDB{
 		std::ifstream ifs(path.c_str(), std::ios_base::binary | std::ios_base::in);
 		boost::archive::binary_iarchive ia(ifs);
 		ia >> (*this);
+		this->rebuildDirectory();
+		this->rebuildValueIndexes();
 
 		ifs.close();
 		return true;
@@ -425,13 +629,106 @@ namespace CoGaDB{
 
 	template<class T>
 	T& BitVectorCompressedColumn<T>::operator[](const int index){
-		return this->values[this->lookup(this->getByTID(index))].getValueRef();
+		return this->values[this->valueIndexByTID(index)].getValueRef();
+	}
+
+	/*
+	The value indexes of the bit positions of [begin, end) are unpacked
+	block wise, positions of removed rows are skipped.
+	*/
+	template<class T>
+	void BitVectorCompressedColumn<T>::decode(TID begin, TID end, T* out){
+		if (begin >= end)
+			return;
+		const unsigned int first = this->validity.select(begin);
+		const unsigned int last = this->validity.select(end - 1) + 1;
+		unsigned int buffer[64];
+		for (unsigned int i = first; i < last; i += 64) {
+			unsigned int n = std::min(64u, last - i);
+			this->value_indexes.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++) {
+				if (this->validity.test(i + k))
+					*out++ = this->values[buffer[k]].getValue();
+			}
+		}
+	}
+
+	/*
+	The result of a selection is the OR of the bitmaps of all qualifying
+	values (a single bitmap for EQUAL), no row is decoded.
+	With several threads, the values are split into one contiguous range per
+	thread, which are ORed as morsels on the global thread pool, and the
+	partial results are ORed at the end.
+	*/
+	template<class T>
+	RoaringBitmap BitVectorCompressedColumn<T>::selectionBitmap(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		if (value_for_comparison.type() != typeid(T)) {
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+
+		const T& value = boost::any_cast<const T&>(value_for_comparison);
+		RoaringBitmap positions;
+		if (comp == EQUAL) {
+			const int index = this->lookup(value);
+			if (index != -1)
+				positions = this->values[index].getBitmap();
+		}
+		else if (number_of_threads <= 1 || this->values.size() < 2 * number_of_threads) {
+			this->orBitmaps(value, comp, 0, this->values.size(), positions);
+		}
+		else {
+			std::vector<RoaringBitmap> partial_results(number_of_threads);
+			ThreadPool::global().run(number_of_threads, number_of_threads, OrChunk(*this, value, comp, partial_results));
+			for (unsigned int i = 0; i < partial_results.size(); i++)
+				positions |= partial_results[i];
+		}
+		return this->toTIDs(positions);
+	}
+
+	template<class T>
+	const PositionListPtr BitVectorCompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		return this->selectionBitmap(value_for_comparison, comp).toPositionList();
+	}
+
+	template<class T>
+	const PositionListPtr BitVectorCompressedColumn<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		return this->selectionBitmap(value_for_comparison, comp, number_of_threads).toPositionList();
+	}
+
+	/*
+	Sorting in the compressed domain: only the d bitmaps are sorted by their
+	values, afterwards the set bits of every bitmap are emitted in value
+	order, which is O(n + d log d). A bitmap is visited in ascending bit
+	order, so equal values stay in ascending TID order.
+	*/
+	template<class T>
+	const PositionListPtr BitVectorCompressedColumn<T>::sort(SortOrder order){
+		if (order != ASCENDING && order != DESCENDING) {
+			std::cout << "FATAL ERROR: BitVectorCompressedColumn<T>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr(new PositionList());
+		}
+
+		std::vector<unsigned int> bitmaps(this->values.size());
+		for (unsigned int j = 0; j < bitmaps.size(); j++)
+			bitmaps[j] = j;
+		std::sort(bitmaps.begin(), bitmaps.end(), BitmapOrder(this->values, order == DESCENDING));
+
+		PositionListPtr ids(new PositionList());
+		ids->reserve(this->elem_num);
+		AppendTIDVisitor visitor(this->validity, this->column_length != this->elem_num, *ids);
+		for (unsigned int j = 0; j < bitmaps.size(); j++)
+			this->values[bitmaps[j]].visit(visitor);
+		return ids;
 	}
 
 	template<class T>
 	unsigned int BitVectorCompressedColumn<T>::getSizeinBytes() const throw(){
-		return this->values.capacity()*sizeof(T)+ //size of different values
-			this->bytes*this->values.size(); //size of the bitvectors
+		unsigned int size_in_bytes = this->values.capacity()*sizeof(BitVector<T>); //size of different values
+		for (unsigned int i = 0; i < this->values.size(); i++)
+			size_in_bytes += this->values[i].getSizeinBytes(); //size of the bitvectors
+		return size_in_bytes + this->validity.getSizeinBytes() + this->value_indexes.getSizeinBytes();
 	}
 
 
@@ -1,41 +1,13 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <compression/bit_packed_vector.hpp>
 #include <vector>
+#include <algorithm>
+#include <boost/iterator/counting_iterator.hpp>
 
 namespace CoGaDB {
 
-	/*
-	
-	This struct "Twee" [ dutch for 'two' ] holds for each different value in the
-	column, which is to be compressed, the count how often it appears in the
-	column (in a block) and it holds the value itself.
-
-	For easier load and store it also has a function serialize.
-	
-	*/
-
-	template<typename T>
-	struct Twee {
-		unsigned int count = 0;
-		T value;
-
-		Twee(){ count = 1; }
-
-		template<typename T>
-		Twee(int c, T val){ count = c; value = val; }
-
-		template<class Archive>
-		void serialize(Archive & ar, const unsigned int version)
-		{
-			ar & count;
-			ar & value;  
-		}
-	};
-
-
-
-
 	template<typename T>
 	class RunLengthCompressionColumn : public  CoGaDB::CompressedColumn<T>
 	{
@@ -64,32 +36,82 @@ namespace CoGaDB {
 		virtual bool load(const std::string& path);
 
 		virtual T& operator[](const int index);
+		virtual void decode(TID begin, TID end, T* out);
+
+		virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+		virtual const PositionListPtr sort(SortOrder order);
+
+		//returns the number of runs, neighbouring runs never have equal values
+		unsigned int getNumberOfRuns() const throw();
 
 		template<class Archive>
 		void serialize(Archive & ar, const unsigned int version)
 		{
 			ar & this->values;
+			ar & this->runEnds;
 			ar & this->elemNum;
 		}
 
+	protected:
+		virtual void groupByKey(typename ColumnBaseTyped<T>::KeyGroups& groups, unsigned int number_of_threads);
+		virtual void selectionKernel(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result);
+
 	private:
 
 		/*
-		
-		A std::vector represents the column. It holds a 'Twee<T>' for each value.
+
+		The runs are stored as two separate arrays (struct of arrays):
+		'values' holds the value of each run, 'runEnds' holds for each run
+		the TID behind its last value (the prefix sum of the run lengths).
+		A run i covers the TIDs [runEnds[i-1], runEnds[i]).
+
+		The run ends are bit packed with the width of the largest end, which
+		is bitsRequired(elemNum), instead of a 32 bit counter per run. They
+		are ascending, so the run of a TID is found by binary search, and a
+		scan over the values does not load any counters.
 
 		We keep track of how many values we have in our column with 'elemNum',
 		so we don't have to calculate everytime.
-		
+
 		*/
 
-		int TIDtoCompressedIndex(TID tid);
-		std::vector<Twee<T>> values;
+		int TIDtoCompressedIndex(TID tid) const;
+		//returns the first run, which ends behind tid (values.size() if there is none)
+		unsigned int findRun(TID tid) const;
+		//appends the run [begin, end) to the runs, it is merged with the last run if the values are equal
+		static void appendRun(std::vector<T>& run_values, BitPackedVector& run_ends, const T& value, TID begin, TID end);
+		//appends the TIDs in [begin, end) of all runs, whose value fulfills the filter condition, to result
+		void scanRuns(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result) const;
+		//sorts the runs as (value, run) pairs in the given order, runs with equal values keep their order
+		void sortRuns(SortOrder order, unsigned int number_of_threads, std::vector<std::pair<T, unsigned int> >& runs) const;
+
+		//orders (value, run) pairs by value, equal values by run
+		struct RunOrder {
+			bool descending;
+			RunOrder(bool descending_) : descending(descending_) {}
+			inline bool operator() (const std::pair<T, unsigned int>& a, const std::pair<T, unsigned int>& b) const {
+				if (a.first < b.first)
+					return !descending;
+				if (b.first < a.first)
+					return descending;
+				return a.second < b.second;
+			}
+		};
+
+		//compares a TID with the end of a run, for binary searches over the run ends
+		struct RunEndComparator {
+			const BitPackedVector& runEnds;
+			RunEndComparator(const BitPackedVector& runEnds_) : runEnds(runEnds_) {}
+			inline bool operator() (TID tid, unsigned int run) const { return tid < runEnds.get(run); }
+		};
+
+		std::vector<T> values;
+		BitPackedVector runEnds;
 		unsigned int elemNum;
 	};
 
 	template<class T>
-	RunLengthCompressionColumn<T>::RunLengthCompressionColumn(const std::string &name, AttributeType db_type) : CompressedColumn<T>(name, db_type){
+	RunLengthCompressionColumn<T>::RunLengthCompressionColumn(const std::string &name, AttributeType db_type) : CompressedColumn<T>(name, db_type), values(), runEnds(){
 		elemNum = 0;
 	}
 
@@ -98,39 +120,54 @@ namespace CoGaDB {
 
 	}
 
+	template<class T>
+	unsigned int RunLengthCompressionColumn<T>::findRun(TID tid) const {
+		return *std::upper_bound(boost::counting_iterator<unsigned int>(0), boost::counting_iterator<unsigned int>(this->runEnds.size()), tid, RunEndComparator(this->runEnds));
+	}
+
 	/*
 	To match the "original" tid of a value with the respective one in the compressed column.
-	It is necessary to compute the respective position in the values-vector.
+	It is necessary to compute the respective position in the values-vector:
+	the first run, which ends behind tid.
 	*/
 	template<class T>
-	int RunLengthCompressionColumn<T>::TIDtoCompressedIndex(TID tid) {
-		unsigned int tid_ = 0;
-		for (unsigned int i = 0; i < this->values.size(); i++) {
-			tid_ += this->values[i].count;
-			if (tid_ > tid)
-				return i;
+	int RunLengthCompressionColumn<T>::TIDtoCompressedIndex(TID tid) const {
+		const unsigned int run = this->findRun(tid);
+		if (run == this->values.size())
+			return -1; //if tid is out of bound -> return -1 => exception is thrown by std::vector
+		return run;
+	}
+
+	template<class T>
+	void RunLengthCompressionColumn<T>::appendRun(std::vector<T>& run_values, BitPackedVector& run_ends, const T& value, TID begin, TID end) {
+		if (begin == end)
+			return;
+		if (!run_values.empty() && run_values.back() == value)
+			run_ends.set(run_ends.size() - 1, end);
+		else {
+			run_values.push_back(value);
+			run_ends.push_back(end);
 		}
-		return -1; //if tid is out of bound -> return -1 => exception is thrown by std::vector
 	}
 
 	/*
-	
+
 	To insert a new value we only have to check whether the last inserted value is
-	equal to the new value. If so we just increase the count of the value.
-	Otherwise we just add the new value to the vector.
-	
+	equal to the new value. If so we just extend the last run.
+	Otherwise we just add a new run.
+
 	*/
 	template<class T>
 	bool RunLengthCompressionColumn<T>::insert(const T &new_value){
-			if (this->values.empty() || this->values[this->values.size() - 1].value != new_value)
+			this->elemNum++;
+			if (this->values.empty() || this->values.back() != new_value)
 			{
-				this->values.push_back(Twee<T>(1, new_value));
-				this->elemNum++;
+				this->values.push_back(new_value);
+				this->runEnds.push_back(this->elemNum);
 				return true;
 			}
 			else {
-				this->values[this->values.size() - 1].count++;
-				this->elemNum++;
+				this->runEnds.set(this->runEnds.size() - 1, this->elemNum);
 				return true;
 			}
 	}
@@ -151,7 +188,7 @@ namespace CoGaDB {
 	template<class T>
 	const boost::any RunLengthCompressionColumn<T>::get(TID tid){
 		if (tid < this->elemNum)
-			return boost::any(this->values[this->TIDtoCompressedIndex(tid)].value);
+			return boost::any(this->values[this->TIDtoCompressedIndex(tid)]);
 
 		std::cout << "fatal Error!!! Invalid TID!!! Attribute: " << this->name_ << " TID: " << tid << std::endl;
 		return boost::any();
@@ -162,7 +199,8 @@ namespace CoGaDB {
 		std::cout << "| " << this->name_ << " |" << std::endl;
 		std::cout << "________________________" << std::endl;
 		for (unsigned int i = 0; i < values.size(); i++){
-			std::cout << "| " << values[i].count << " | " << values[i].value << " |" << std::endl;
+			const unsigned int count = this->runEnds.get(i) - (i == 0 ? 0 : this->runEnds.get(i - 1));
+			std::cout << "| " << count << " | " << values[i] << " |" << std::endl;
 		}
 
 	}
@@ -171,108 +209,113 @@ namespace CoGaDB {
 		return this->elemNum;
 	}
 	template<class T>
+	unsigned int RunLengthCompressionColumn<T>::getNumberOfRuns() const throw(){
+		return this->values.size();
+	}
+	template<class T>
 	const ColumnPtr RunLengthCompressionColumn<T>::copy() const{
 		return ColumnPtr(new RunLengthCompressionColumn(*this)); //no dynamic memory allocations or pointer variables
 	}
 
+	/*
+	The run of tid is split into at most three runs (the values before tid,
+	the new value and the values after tid), which are merged with equal
+	neighbours. Only the runs from the left to the right neighbour are
+	replaced, the number of values does not change, so all other run ends
+	stay valid.
+	*/
 	template<class T>
 	bool RunLengthCompressionColumn<T>::update(TID tid, const boost::any& obj){
+		if (typeid(T) != obj.type() || tid >= this->elemNum)
+			return false;
 
-		//// Find index in compressed column and respective offset of tid in this block
-		if (typeid(T) == obj.type()) {
-			int tid_ = 0, index, offset;
-			for (unsigned int i = 0; i < this->values.size(); i++) {
-				for (unsigned int j = 0; j < this->values[i].count; j++) {
-					if (tid == tid_) {
-						offset = j;
-						index = i;
-					}
-					tid_++;
-				}
-			}
-
-			std::vector<T> left; // the "Twee-Block" of the values "left" (before) the updated "Twee-Block"
-			std::vector<T> right; // the "Twee-Block" of the values "right" (after) the updated "Twee-Block"
-
-			if (index != 0)
-				left.insert(left.begin(), this->values[index - 1].count, this->values[index - 1].value);
-			if (index != this->values.size() - 1)
-				right.insert(right.begin(), this->values[index + 1].count, this->values[index + 1].value);
-
-
-			//Merging left, right and the updated TweeBlock to a list (in correct order)
-			std::vector<T> list(this->values[index].count, this->values[index].value);
-			list[offset] = boost::any_cast<T>(obj);
-
-			list.insert(list.begin(), left.begin(), left.end());
-			list.insert(list.end(), right.begin(), right.end());
-
-			//Check whether we are at the beginning or end of a column
-			//=> so we have no Twee-Block before the updated Block or after it.
-			if (!left.empty())
-				this->values[index - 1].count = 0;
-			if (!right.empty())
-				this->values[index + 1].count = 0;
-			this->values[index].count = 0;
-
+		const T& value = boost::any_cast<const T&>(obj);
+		const unsigned int index = this->TIDtoCompressedIndex(tid);
+		if (this->values[index] == value)
+			return true;
 
-			//"Before","After" and the updated Block are marked as 'count == 0'
-			//They need to be deleted to afterwards  put the std::vector list at the right position
-			for (int i = this->values.size() - 1; i >= 0; i--){
-				if (this->values[i].count == 0)
-					this->values.erase(this->values.begin() + i);
-			}
+		const unsigned int first = index == 0 ? 0 : index - 1;
+		const unsigned int last = std::min<unsigned int>(index + 2, this->values.size());
+		const TID start = index == 0 ? 0 : this->runEnds.get(index - 1);
+		const TID end = this->runEnds.get(index);
+
+		std::vector<T> run_values;
+		BitPackedVector run_ends;
+		if (first < index)
+			appendRun(run_values, run_ends, this->values[first], first == 0 ? 0 : this->runEnds.get(first - 1), start);
+		appendRun(run_values, run_ends, this->values[index], start, tid);
+		appendRun(run_values, run_ends, value, tid, tid + 1);
+		appendRun(run_values, run_ends, this->values[index], tid + 1, end);
+		if (index + 1 < last)
+			appendRun(run_values, run_ends, this->values[index + 1], end, this->runEnds.get(index + 1));
+
+		this->values.erase(this->values.begin() + first, this->values.begin() + last);
+		this->values.insert(this->values.begin() + first, run_values.begin(), run_values.end());
+		this->runEnds.replace(first, last, run_ends);
+		return true;
+	}
 
+	/*
+	The sorted TIDs are merged with the runs in a single pass, which builds
+	the new runs: every run is split at the updated TIDs of its range.
+	*/
+	template<class T>
+	bool RunLengthCompressionColumn<T>::update(PositionListPtr posPtr, const boost::any& obj){
+		if (!posPtr || typeid(T) != obj.type())
+			return false;
+		if (posPtr->empty())
+			return true;
 
-			//Build Twees from list
-			std::vector<Twee<T>> newTwees;
+		PositionListPtr tids = sortedPositionList(posPtr);
+		if (tids->back() >= this->elemNum)
+			return false;
 
-			int count;
-			unsigned short insert = 0;
-			for (unsigned int i = 0; i < list.size(); i += count){
-				count = 1;
-				for (unsigned int j = i; j + 1 < list.size(); j++) {
-					if (list[i] == list[j + 1])
-						count++;
-					else break;
-				}
-				newTwees.push_back(Twee<T>(count, list[i]));
+		const T& value = boost::any_cast<const T&>(obj);
+		std::vector<T> run_values;
+		BitPackedVector run_ends;
+		run_values.reserve(this->values.size() + 2 * tids->size());
+		unsigned int k = 0;
+		TID pos = 0;
+		for (unsigned int i = 0; i < this->values.size(); i++) {
+			const TID end = this->runEnds.get(i);
+			while (k < tids->size() && (*tids)[k] < end) {
+				const TID tid = (*tids)[k++];
+				if (tid < pos) //duplicate TID
+					continue;
+				appendRun(run_values, run_ends, this->values[i], pos, tid);
+				appendRun(run_values, run_ends, value, tid, tid + 1);
+				pos = tid + 1;
 			}
-
-
-			//Insert the TweeBlocks at the right position in the column vector
-			unsigned int new_index = index != 0 ? index - 1 : 0;
-			for (int i = newTwees.size() - 1; i >= 0; i--)
-				this->values.insert(this->values.begin() + new_index, newTwees[i]);
-
-			return true;
+			appendRun(run_values, run_ends, this->values[i], pos, end);
+			pos = end;
 		}
-		else
-			return false;
-
-	}
 
-	template<class T>
-	bool RunLengthCompressionColumn<T>::update(PositionListPtr posPtr, const boost::any& obj){
-		for (unsigned int i = 0; i < posPtr->size(); i++)
-			if (!this->update(posPtr->at(i), obj))
-				return false;
-		
+		this->values.swap(run_values);
+		std::swap(this->runEnds, run_ends);
 		return true;
 	}
 
-	//To erase a value simply decrese the count or erase the value from 
-	//the column if count == 0.
+	//To erase a value simply shorten its run or erase the run from
+	//the column if it becomes empty.
 	template<class T>
 	bool RunLengthCompressionColumn<T>::remove(TID tid){
 		if (tid < this->elemNum) {
 			int index = this->TIDtoCompressedIndex(tid);
 
-			this->values[index].count--;
 			this->elemNum--;
+			for (unsigned int i = index; i < this->runEnds.size(); i++)
+				this->runEnds.set(i, this->runEnds.get(i) - 1);
 
-			if (this->values[index].count == 0)
+			if (this->runEnds.get(index) == (index == 0 ? 0 : this->runEnds.get(index - 1))) {
 				this->values.erase(this->values.begin() + index);
+				this->runEnds.erase(index);
+				//the neighbours of the removed run meet, they become one run if their values are equal (like appendRun)
+				if (index > 0 && (unsigned int)index < this->values.size() && this->values[index - 1] == this->values[index]) {
+					this->runEnds.set(index - 1, this->runEnds.get(index));
+					this->values.erase(this->values.begin() + index);
+					this->runEnds.erase(index);
+				}
+			}
 
 			return true;
 		}
@@ -280,18 +323,48 @@ namespace CoGaDB {
 		return false;
 	}
 
+	/*
+	One pass over the runs: each run is shortened by the number of TIDs in
+	its range. Runs that become empty are dropped, so their neighbours are
+	merged if they hold the same value.
+	*/
 	template<class T>
 	bool RunLengthCompressionColumn<T>::remove(PositionListPtr posPtr){
-		for (unsigned int i = 0; i < posPtr->size(); i++)
-			if (!this->remove(posPtr->at(i)))
-				return false;
+		if (!posPtr)
+			return false;
+		//an empty TID list is an error, like in Column<T>::remove()
+		if (posPtr->empty())
+			return false;
+
+		PositionListPtr tids = sortedPositionList(posPtr);
+		if (tids->back() >= this->elemNum)
+			return false;
+
+		std::vector<T> run_values;
+		BitPackedVector run_ends;
+		run_values.reserve(this->values.size());
+		unsigned int k = 0, removed = 0;
+		TID begin = 0;
+		for (unsigned int i = 0; i < this->values.size(); i++) {
+			const TID end = this->runEnds.get(i);
+			for (; k < tids->size() && (*tids)[k] < end; k++) {
+				if (k == 0 || (*tids)[k] != (*tids)[k - 1]) //skip duplicate TIDs
+					removed++;
+			}
+			appendRun(run_values, run_ends, this->values[i], begin, end - removed);
+			begin = end - removed;
+		}
 
+		this->values.swap(run_values);
+		std::swap(this->runEnds, run_ends);
+		this->elemNum -= removed;
 		return true;
 	}
 
 	template<class T>
 	bool RunLengthCompressionColumn<T>::clearContent(){
 		this->values.clear();
+		this->runEnds.clear();
 		this->elemNum = 0;
 		return true;
 	}
@@ -326,12 +399,159 @@ namespace CoGaDB {
 
 	template<class T>
 	T& RunLengthCompressionColumn<T>::operator[](const int index){
-		return values[this->TIDtoCompressedIndex(index)].value;
+		return values[this->TIDtoCompressedIndex(index)];
+	}
+
+	//the run of begin is searched once, afterwards every run fills its part of the range
+	template<class T>
+	void RunLengthCompressionColumn<T>::decode(TID begin, TID end, T* out){
+		TID tid = begin;
+		for (unsigned int run = tid < end ? this->findRun(tid) : 0; tid < end; run++) {
+			const TID run_end = std::min(end, (TID)this->runEnds.get(run));
+			out = std::fill_n(out, run_end - tid, this->values[run]);
+			tid = run_end;
+		}
+	}
+
+	/*
+	The run ends are decoded block wise, the values are read from their own
+	array, so the comparison loop touches no run lengths. The first and the
+	last run are cut at begin and end.
+	*/
+	template<class T>
+	void RunLengthCompressionColumn<T>::scanRuns(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result) const{
+		if (begin >= end)
+			return;
+		const unsigned int first = this->findRun(begin);
+		const unsigned int last = this->findRun(end - 1) + 1;
+
+		unsigned int ends[64];
+		TID run_begin = begin;
+		for (unsigned int i = first; i < last; i += 64) {
+			const unsigned int n = std::min(64u, last - i);
+			this->runEnds.unpack(i, n, ends);
+			for (unsigned int k = 0; k < n; k++) {
+				const T& run_value = this->values[i + k];
+				const TID run_end = std::min(end, (TID)ends[k]);
+				bool match = false;
+				if (comp == EQUAL)
+					match = run_value == value;
+				else if (comp == LESSER)
+					match = run_value < value;
+				else if (comp == GREATER)
+					match = run_value > value;
+
+				if (match) { //the whole run qualifies
+					const size_t pos = result.size();
+					result.resize(pos + run_end - run_begin);
+					for (TID tid = run_begin; tid < run_end; tid++)
+						result[pos + tid - run_begin] = tid;
+				}
+				run_begin = run_end;
+			}
+		}
+	}
+
+	/*
+	The predicate is evaluated once per run, a matching run emits its whole
+	TID range.
+	*/
+	template<class T>
+	const PositionListPtr RunLengthCompressionColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		if (value_for_comparison.type() != typeid(T)) {
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+
+		PositionListPtr result_tids(new PositionList());
+		this->scanRuns(boost::any_cast<const T&>(value_for_comparison), comp, 0, this->elemNum, *result_tids);
+		return result_tids;
+	}
+
+	//the runs are only sorted if they are not in the requested order yet
+	template<class T>
+	void RunLengthCompressionColumn<T>::sortRuns(SortOrder order, unsigned int number_of_threads, std::vector<std::pair<T, unsigned int> >& runs) const{
+		const RunOrder comp(order == DESCENDING);
+		runs.reserve(this->values.size());
+		bool sorted = true;
+		for (unsigned int i = 0; i < this->values.size(); i++) {
+			runs.push_back(std::pair<T, unsigned int>(this->values[i], i));
+			if (i > 0 && comp(runs[i], runs[i - 1]))
+				sorted = false;
+		}
+		if (!sorted)
+			parallelSort(runs, number_of_threads, comp);
+	}
+
+	/*
+	The runs are grouped instead of the rows: they are sorted by value
+	(unless they already are in ascending order) and every run becomes a
+	group with its TID range, so sort_merge_join() merges runs.
+	*/
+	template<class T>
+	void RunLengthCompressionColumn<T>::groupByKey(typename ColumnBaseTyped<T>::KeyGroups& groups, unsigned int number_of_threads){
+		std::vector<std::pair<T, unsigned int> > runs;
+		this->sortRuns(ASCENDING, number_of_threads, runs);
+
+		groups.keys.reserve(runs.size());
+		groups.first.reserve(runs.size());
+		groups.last.reserve(runs.size());
+		for (unsigned int i = 0; i < runs.size(); i++) {
+			const unsigned int run = runs[i].second;
+			groups.keys.push_back(runs[i].first);
+			groups.first.push_back(run == 0 ? 0 : this->runEnds.get(run - 1));
+			groups.last.push_back(this->runEnds.get(run));
+		}
+	}
+
+	/*
+	Sorting in the compressed domain: only the r runs are sorted
+	(O(r log r)), afterwards every run is expanded to its TID range. Runs
+	with equal values keep their order, so equal values stay in ascending
+	TID order for both sort orders.
+	*/
+	template<class T>
+	const PositionListPtr RunLengthCompressionColumn<T>::sort(SortOrder order){
+		if (order != ASCENDING && order != DESCENDING) {
+			std::cout << "FATAL ERROR: RunLengthCompressionColumn<T>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr(new PositionList());
+		}
+
+		std::vector<std::pair<T, unsigned int> > runs;
+		this->sortRuns(order, ThreadPool::global().getNumberOfWorkers() + 1, runs);
+
+		PositionListPtr ids(new PositionList(this->elemNum));
+		PositionList::iterator it = ids->begin();
+		for (unsigned int i = 0; i < runs.size(); i++) {
+			const unsigned int run = runs[i].second;
+			const TID end = this->runEnds.get(run);
+			for (TID tid = run == 0 ? 0 : this->runEnds.get(run - 1); tid < end; tid++)
+				*it++ = tid;
+		}
+		return ids;
+	}
+
+	//a morsel of parallel_selection() only visits the runs, which overlap its TID range
+	template<class T>
+	void RunLengthCompressionColumn<T>::selectionKernel(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result){
+		this->scanRuns(value, comp, begin, end, result);
 	}
 
 	template<class T>
 	unsigned int RunLengthCompressionColumn<T>::getSizeinBytes() const throw(){
-		return this->values.capacity()*sizeof(T);
+		return this->values.capacity()*sizeof(T)+ //Run values
+			this->runEnds.getSizeinBytes(); //Run ends
+	}
+
+	//total template specialization, the characters of the strings are stored outside of the vector
+	template<>
+	inline unsigned int RunLengthCompressionColumn<std::string>::getSizeinBytes() const throw(){
+		unsigned int size_in_bytes = this->values.capacity()*sizeof(std::string);
+		for (unsigned int i = 0; i < this->values.size(); i++)
+			size_in_bytes += this->values[i].capacity();
+		return size_in_bytes+ //Run values
+			this->runEnds.getSizeinBytes(); //Run ends
 	}
 
-}
\ No newline at end of file
+}
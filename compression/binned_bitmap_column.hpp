@@ -0,0 +1,585 @@
+#pragma once
+
+#include <core/compressed_column.hpp>
+#include <compression/bitmap.hpp>
+#include <compression/roaring_bitmap.hpp>
+#include <compression/bit_packed_vector.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+namespace CoGaDB{
+
+	/*
+
+	Order preserving unsigned keys of the values of a binned column:
+	a < b if and only if key(a) < key(b). The bins and the offsets of the
+	values inside their bin are computed on the keys.
+
+	*/
+	template<typename T>
+	struct BinKey;
+
+	template<>
+	struct BinKey<int> {
+		static unsigned int key(int value) { return (unsigned int)value ^ 0x80000000u; }
+		static int value(unsigned int key) { return (int)(key ^ 0x80000000u); }
+	};
+
+	//the sign bit is set for positive floats, all bits are flipped for negative ones, -0.0 is stored as 0.0
+	template<>
+	struct BinKey<float> {
+		static unsigned int key(float value) {
+			if (value == 0.0f)
+				value = 0.0f;
+			unsigned int bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+		}
+		static float value(unsigned int key) {
+			const unsigned int bits = (key & 0x80000000u) ? key & 0x7fffffffu : ~key;
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+	};
+
+	/*
+
+	Binned bitmap compression for INT and FLOAT columns with (almost)
+	unique values, e.g., measurements, where a bitmap per distinct value
+	(see BitVectorCompressedColumn) would cost more than the values.
+
+	The rows fall into at most 'bin_count' bins of value ranges. The bins
+	are equi depth: the bounds are quantiles of the values, so every bin
+	holds about the same number of rows. Bin b holds the values in
+	[bounds[b-1], bounds[b]), the first and the last bin are open.
+
+	A row is stored as its bin and the offset of its value inside the bin,
+	both bit packed. The offset is computed on the order preserving key of
+	the value (see BinKey): key - bounds[b-1], in the first bin
+	bounds[0] - 1 - key. So a row costs log2(bin_count) bits plus the bits
+	of the widest bin instead of sizeof(T).
+
+	The bitmaps are range encoded: ranges[b] holds the positions of all
+	rows in the bins 0..b. A range predicate is answered with one or two
+	bitmap operations, only the rows of the bin that contains the constant
+	are candidates, whose offsets are decoded to check their exact value:
+
+	value < v:  ranges[bin(v)-1]              + candidates of bin(v)
+	value > v:  ranges[last] ANDNOT ranges[bin(v)] + candidates of bin(v)
+	value == v:                                 candidates of bin(v)
+
+	Like in BitVectorCompressedColumn, every row has a bit position and the
+	validity bitmap marks the used ones, the TID of a row is the rank of its
+	position. Removing a row only clears its bits in the validity bitmap and
+	the range bitmaps. The positions are renumbered by compact(), once more
+	than half of them are unused, and whenever the bounds are chosen again
+	(the column doubled its size since the last binning).
+
+	*/
+	template<class T>
+	class BinnedBitmapColumn : public CompressedColumn<T>{
+	public:
+		BinnedBitmapColumn(const std::string& name, AttributeType db_type, unsigned int bin_count = 16);
+		virtual ~BinnedBitmapColumn();
+
+		virtual bool insert(const boost::any& new_Value);
+		virtual bool insert(const T& new_value);
+		template <typename InputIterator>
+		bool insert(InputIterator first, InputIterator last);
+
+		virtual bool update(TID tid, const boost::any& new_value);
+		virtual bool update(PositionListPtr tid, const boost::any& new_value);
+
+		virtual bool remove(TID tid);
+		virtual bool remove(PositionListPtr tid);
+		virtual bool clearContent();
+
+		virtual const boost::any get(TID tid);
+		virtual void print() const throw();
+		virtual size_t size() const throw();
+		virtual unsigned int getSizeinBytes() const throw();
+
+		virtual const ColumnPtr copy() const;
+
+		virtual bool store(const std::string& path);
+		virtual bool load(const std::string& path);
+
+		//returns a decoded copy of the row, which the next call overwrites, writing to it does not change the column
+		virtual T& operator[](const int index);
+		virtual void decode(TID begin, TID end, T* out);
+
+		virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+		virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+
+		/*! \brief returns the TIDs of all rows, which fulfill the filter condition, as a bitmap
+		 *  \details the results of several columns can be combined with AND/OR (see RoaringBitmap)*/
+		RoaringBitmap selectionBitmap(const boost::any& value_for_comparison, const ValueComparator comp);
+
+		//chooses new equi depth bounds for the current values and encodes all rows again
+		void rebin();
+		//renumbers the bit positions, so that the rows occupy the positions [0, size())
+		void compact();
+
+		template<class Archive>
+		void serialize(Archive & ar, const unsigned int)
+		{
+			ar & this->bounds;
+			ar & this->bins;
+			ar & this->offsets;
+			ar & this->validity;
+			ar & this->column_length;
+			ar & this->elem_num;
+			ar & this->bin_count;
+			ar & this->binned_size;
+		}
+
+	private:
+		//keys of the lower bounds of the bins 1..n, ascending
+		std::vector<unsigned int> bounds;
+		//bin and offset of the value at every bit position
+		BitPackedVector bins;
+		BitPackedVector offsets;
+		//ranges[b] holds the bit positions of all rows in the bins 0..b
+		std::vector<RoaringBitmap> ranges;
+		//a bit position holds a row if its bit is set
+		RankSelectBitmap validity;
+		//number of used bit positions and number of rows
+		unsigned int column_length;
+		unsigned int elem_num;
+		unsigned int bin_count;
+		//number of rows at the last binning
+		unsigned int binned_size;
+		//the copy returned by operator[]
+		T decoded;
+
+		unsigned int bin(unsigned int key) const {
+			return (unsigned int)(std::upper_bound(this->bounds.begin(), this->bounds.end(), key) - this->bounds.begin());
+		}
+
+		unsigned int offsetOf(unsigned int key, unsigned int b) const {
+			return b == 0 ? this->bounds[0] - 1 - key : key - this->bounds[b - 1];
+		}
+
+		T valueOf(unsigned int b, unsigned int offset) const {
+			return BinKey<T>::value(b == 0 ? this->bounds[0] - 1 - offset : this->bounds[b - 1] + offset);
+		}
+
+		T valueAt(unsigned int bitpos) const {
+			return this->valueOf(this->bins.get(bitpos), this->offsets.get(bitpos));
+		}
+
+		//stores a row at the next bit position and returns its bin, the range bitmaps are not changed
+		unsigned int appendRow(const T& value);
+
+		//encodes the rows again with the current bounds, without unused bit positions
+		void rebuild(const std::vector<T>& values);
+		//chooses the bounds for values and encodes them
+		void rebin(const std::vector<T>& values);
+		//fills the range bitmaps from the bins of the used bit positions
+		void rebuildBitmaps();
+
+		//clears the bits of the row at bitpos, see remove()
+		void removeRow(unsigned int bitpos);
+
+		void compactIfNeeded() {
+			const unsigned int unused = this->column_length - this->elem_num;
+			if (unused > 4096 && unused > this->column_length / 2)
+				this->compact();
+		}
+
+		//translates bit positions to TIDs, they are the same as long as no position is unused
+		RoaringBitmap toTIDs(const RoaringBitmap& positions) const {
+			if (this->column_length == this->elem_num)
+				return positions;
+			RoaringBitmap tids;
+			TIDVisitor visitor(this->validity, tids);
+			positions.visit(visitor);
+			return tids;
+		}
+
+		struct TIDVisitor {
+			const RankSelectBitmap& validity;
+			RoaringBitmap& tids;
+			TIDVisitor(const RankSelectBitmap& validity_, RoaringBitmap& tids_) : validity(validity_), tids(tids_) {}
+			void operator() (unsigned int bitpos) { tids.set(validity.rank(bitpos)); }
+		};
+
+		//collects the candidates of bin b, which fulfill the filter condition
+		struct CandidateFilter {
+			const BinnedBitmapColumn<T>& column;
+			const unsigned int b;
+			const T& value;
+			const ValueComparator comp;
+			RoaringBitmap& result;
+			CandidateFilter(const BinnedBitmapColumn<T>& column_, unsigned int b_, const T& value_, const ValueComparator comp_, RoaringBitmap& result_)
+				: column(column_), b(b_), value(value_), comp(comp_), result(result_) {}
+			void operator() (unsigned int bitpos) {
+				const T row_value = column.valueOf(b, column.offsets.get(bitpos));
+				if ((comp == EQUAL && row_value == value) || (comp == LESSER && row_value < value) || (comp == GREATER && row_value > value))
+					result.set(bitpos);
+			}
+		};
+	};
+
+
+/***************** Start of Implementation Section ******************/
+
+
+	template<class T>
+	BinnedBitmapColumn<T>::BinnedBitmapColumn(const std::string& name, AttributeType db_type, unsigned int bin_count_)
+		: CompressedColumn<T>(name, db_type), bounds(), bins(), offsets(), ranges(1), validity(), column_length(0), elem_num(0),
+		bin_count(std::max(2u, bin_count_)), binned_size(0), decoded(){
+
+	}
+
+	template<class T>
+	BinnedBitmapColumn<T>::~BinnedBitmapColumn(){
+
+	}
+
+	template<class T>
+	void BinnedBitmapColumn<T>::rebin(){
+		std::vector<T> values;
+		this->decodeColumn(values);
+		this->rebin(values);
+	}
+
+	template<class T>
+	void BinnedBitmapColumn<T>::rebin(const std::vector<T>& values){
+		std::vector<unsigned int> keys(values.size());
+		for (size_t i = 0; i < values.size(); i++)
+			keys[i] = BinKey<T>::key(values[i]);
+		std::sort(keys.begin(), keys.end());
+
+		this->bounds.clear();
+		for (unsigned int i = 1; i < this->bin_count && !keys.empty(); i++) {
+			const unsigned int bound = keys[(size_t)keys.size() * i / this->bin_count];
+			if (this->bounds.empty() || this->bounds.back() < bound) //frequent values would give empty bins
+				this->bounds.push_back(bound);
+		}
+		this->binned_size = (unsigned int)values.size();
+		this->rebuild(values);
+	}
+
+	template<class T>
+	void BinnedBitmapColumn<T>::compact(){
+		if (this->column_length == this->elem_num)
+			return;
+		std::vector<T> values;
+		this->decodeColumn(values);
+		this->rebuild(values);
+	}
+
+	template<class T>
+	void BinnedBitmapColumn<T>::rebuild(const std::vector<T>& values){
+		this->bins.clear();
+		this->offsets.clear();
+		this->validity.clear();
+		this->column_length = 0;
+		this->elem_num = 0;
+		for (size_t i = 0; i < values.size(); i++)
+			this->appendRow(values[i]);
+		this->rebuildBitmaps();
+	}
+
+	/*
+	Every row is added to the bitmap of its own bin first, afterwards each
+	bitmap is ORed with the one of the previous bin.
+	*/
+	template<class T>
+	void BinnedBitmapColumn<T>::rebuildBitmaps(){
+		std::vector<RoaringBitmap> ranges(this->bounds.size() + 1);
+		unsigned int buffer[64];
+		for (unsigned int i = 0; i < this->column_length; i += 64) {
+			const unsigned int n = std::min(64u, this->column_length - i);
+			this->bins.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++) {
+				if (this->validity.test(i + k))
+					ranges[buffer[k]].set(i + k);
+			}
+		}
+		for (unsigned int b = 1; b < ranges.size(); b++)
+			ranges[b] |= ranges[b - 1];
+		this->ranges.swap(ranges);
+	}
+
+	template<class T>
+	unsigned int BinnedBitmapColumn<T>::appendRow(const T& value){
+		const unsigned int key = BinKey<T>::key(value);
+		const unsigned int b = this->bin(key);
+		if (this->column_length % 64 == 0)
+			this->validity.addWord();
+		this->validity.set(this->column_length);
+		this->bins.push_back(b);
+		this->offsets.push_back(this->offsetOf(key, b));
+		this->column_length++;
+		this->elem_num++;
+		return b;
+	}
+
+	template<class T>
+	bool BinnedBitmapColumn<T>::insert(const boost::any& new_value){
+		if (new_value.empty())
+			return false;
+		if (typeid(T) == new_value.type())
+			return this->insert(boost::any_cast<T>(new_value));
+		return false;
+	}
+
+	template<class T>
+	bool BinnedBitmapColumn<T>::insert(const T& new_value){
+		//until the first binning, the first value splits the column into two bins
+		if (this->bounds.empty()) {
+			this->bounds.push_back(BinKey<T>::key(new_value));
+			this->ranges.resize(2);
+		}
+		const unsigned int bitpos = this->column_length;
+		for (unsigned int b = this->appendRow(new_value); b < this->ranges.size(); b++)
+			this->ranges[b].set(bitpos);
+		if (this->elem_num >= 2 * this->binned_size + this->bin_count)
+			this->rebin();
+		return true;
+	}
+
+	//the rows are appended one by one, so a batch is rebinned only when the column doubled its size
+	template <typename T>
+	template <typename InputIterator>
+	bool BinnedBitmapColumn<T>::insert(InputIterator first, InputIterator last){
+		if (!(first < last))
+			return false;
+		for (InputIterator it = first; it != last; it++)
+			this->insert(*it);
+		return true;
+	}
+
+	//the row leaves the bitmaps between its old and its new bin or joins them
+	template<class T>
+	bool BinnedBitmapColumn<T>::update(TID tid, const boost::any& obj){
+		if (obj.empty() || typeid(T) != obj.type() || tid >= this->elem_num)
+			return false;
+
+		const unsigned int key = BinKey<T>::key(boost::any_cast<const T&>(obj));
+		const unsigned int bitpos = this->validity.select(tid);
+		const unsigned int old_bin = this->bins.get(bitpos);
+		const unsigned int new_bin = this->bin(key);
+		for (unsigned int b = old_bin; b < new_bin; b++)
+			this->ranges[b].reset(bitpos);
+		for (unsigned int b = new_bin; b < old_bin; b++)
+			this->ranges[b].set(bitpos);
+		this->bins.set(bitpos, new_bin);
+		this->offsets.set(bitpos, this->offsetOf(key, new_bin));
+		return true;
+	}
+
+	template<class T>
+	bool BinnedBitmapColumn<T>::update(PositionListPtr tids, const boost::any& obj){
+		if (!tids)
+			return false;
+		for (unsigned int i = 0; i < tids->size(); i++) {
+			if (!this->update((*tids)[i], obj))
+				return false;
+		}
+		return true;
+	}
+
+	template<class T>
+	void BinnedBitmapColumn<T>::removeRow(unsigned int bitpos){
+		for (unsigned int b = this->bins.get(bitpos); b < this->ranges.size(); b++)
+			this->ranges[b].reset(bitpos);
+		this->validity.reset(bitpos);
+		this->elem_num--;
+	}
+
+	template<class T>
+	bool BinnedBitmapColumn<T>::remove(TID tid){
+		if (tid >= this->elem_num)
+			return false;
+		this->removeRow(this->validity.select(tid));
+		this->compactIfNeeded();
+		return true;
+	}
+
+	//the bit positions of all TIDs are looked up first, while the TIDs still refer to the same rows
+	template<class T>
+	bool BinnedBitmapColumn<T>::remove(PositionListPtr posPtr){
+		if (!posPtr)
+			return false;
+		//an empty TID list is an error, like in Column<T>::remove()
+		if (posPtr->empty())
+			return false;
+
+		PositionListPtr tids = sortedPositionList(posPtr);
+		if (tids->back() >= this->elem_num)
+			return false;
+
+		std::vector<unsigned int> positions;
+		positions.reserve(tids->size());
+		for (unsigned int k = 0; k < tids->size(); k++) {
+			if (k == 0 || (*tids)[k] != (*tids)[k - 1]) //skip duplicate TIDs
+				positions.push_back(this->validity.select((*tids)[k]));
+		}
+		for (unsigned int k = 0; k < positions.size(); k++)
+			this->removeRow(positions[k]);
+		this->compactIfNeeded();
+		return true;
+	}
+
+	template<class T>
+	bool BinnedBitmapColumn<T>::clearContent(){
+		this->bounds.clear();
+		this->bins.clear();
+		this->offsets.clear();
+		this->ranges.assign(1, RoaringBitmap());
+		this->validity.clear();
+		this->column_length = 0;
+		this->elem_num = 0;
+		this->binned_size = 0;
+		return true;
+	}
+
+	template<class T>
+	const boost::any BinnedBitmapColumn<T>::get(TID tid){
+		if (tid < this->elem_num)
+			return boost::any(this->valueAt(this->validity.select(tid)));
+
+		std::cout << "fatal Error!!! Invalid TID!!! Attribute: " << this->name_ << " TID: " << tid << std::endl;
+		return boost::any();
+	}
+
+	template<class T>
+	void BinnedBitmapColumn<T>::print() const throw(){
+		std::cout << "| " << this->name_ << " |" << std::endl;
+		std::cout << "________________________" << std::endl;
+		for (unsigned int i = 0; i < this->column_length; i++) {
+			if (this->validity.test(i))
+				std::cout << "| " << this->bins.get(i) << " | " << this->valueAt(i) << " |" << std::endl;
+		}
+	}
+
+	template<class T>
+	size_t BinnedBitmapColumn<T>::size() const throw(){
+		return this->elem_num;
+	}
+
+	template<class T>
+	const ColumnPtr BinnedBitmapColumn<T>::copy() const{
+		return ColumnPtr(new BinnedBitmapColumn(*this));
+	}
+
+	template<class T>
+	bool BinnedBitmapColumn<T>::store(const std::string& path_){
+		std::string path(path_);
+		path += "/";
+		path += this->name_;
+
+		std::ofstream ofs(path.c_str(), std::ios_base::binary | std::ios_base::out);
+		boost::archive::binary_oarchive oa(ofs);
+		oa << (*this);
+
+		ofs.flush();
+		ofs.close();
+		return true;
+	}
+
+	//the bitmaps are not stored, they are rebuilt from the bins
+	template<class T>
+	bool BinnedBitmapColumn<T>::load(const std::string& path_){
+		std::string path(path_);
+		path += "/";
+		path += this->name_;
+
+		std::ifstream ifs(path.c_str(), std::ios_base::binary | std::ios_base::in);
+		boost::archive::binary_iarchive ia(ifs);
+		ia >> (*this);
+		this->rebuildBitmaps();
+
+		ifs.close();
+		return true;
+	}
+
+	template<class T>
+	T& BinnedBitmapColumn<T>::operator[](const int index){
+		this->decoded = this->valueAt(this->validity.select(index));
+		return this->decoded;
+	}
+
+	/*
+	The bins and offsets of the bit positions of [begin, end) are unpacked
+	block wise, positions of removed rows are skipped.
+	*/
+	template<class T>
+	void BinnedBitmapColumn<T>::decode(TID begin, TID end, T* out){
+		if (begin >= end)
+			return;
+		const unsigned int first = this->validity.select(begin);
+		const unsigned int last = this->validity.select(end - 1) + 1;
+		const bool gaps = last - first != end - begin;
+		unsigned int bin_buffer[64], offset_buffer[64];
+		for (unsigned int i = first; i < last; i += 64) {
+			const unsigned int n = std::min(64u, last - i);
+			this->bins.unpack(i, n, bin_buffer);
+			this->offsets.unpack(i, n, offset_buffer);
+			for (unsigned int k = 0; k < n; k++) {
+				if (!gaps || this->validity.test(i + k))
+					*out++ = this->valueOf(bin_buffer[k], offset_buffer[k]);
+			}
+		}
+	}
+
+	template<class T>
+	RoaringBitmap BinnedBitmapColumn<T>::selectionBitmap(const boost::any& value_for_comparison, const ValueComparator comp){
+		if (value_for_comparison.type() != typeid(T)) {
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+
+		const T& value = boost::any_cast<const T&>(value_for_comparison);
+		if (this->elem_num == 0)
+			return RoaringBitmap();
+		const unsigned int b = this->bin(BinKey<T>::key(value));
+
+		//all rows of the bins completely below or above the constant qualify
+		RoaringBitmap result;
+		if (comp == LESSER && b > 0)
+			result = this->ranges[b - 1];
+		else if (comp == GREATER)
+			result = this->ranges.back().andNot(this->ranges[b]);
+
+		RoaringBitmap candidates = b == 0 ? this->ranges[0] : this->ranges[b].andNot(this->ranges[b - 1]);
+		RoaringBitmap matches;
+		CandidateFilter filter(*this, b, value, comp, matches);
+		candidates.visit(filter);
+		result |= matches;
+		return this->toTIDs(result);
+	}
+
+	template<class T>
+	const PositionListPtr BinnedBitmapColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		return this->selectionBitmap(value_for_comparison, comp).toPositionList();
+	}
+
+	//one or two bitmap operations and the candidates of one bin, there is nothing to split into morsels
+	template<class T>
+	const PositionListPtr BinnedBitmapColumn<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int){
+		return this->selection(value_for_comparison, comp);
+	}
+
+	template<class T>
+	unsigned int BinnedBitmapColumn<T>::getSizeinBytes() const throw(){
+		unsigned int size_in_bytes = this->bounds.capacity()*sizeof(unsigned int)+ //Bin bounds
+			this->bins.getSizeinBytes()+ //Bins
+			this->offsets.getSizeinBytes()+ //Offsets inside the bins
+			this->validity.getSizeinBytes()+ //Used bit positions
+			this->ranges.capacity()*sizeof(RoaringBitmap);
+		for (unsigned int b = 0; b < this->ranges.size(); b++)
+			size_in_bytes += this->ranges[b].getSizeinBytes(); //Range encoded bitmaps
+		return size_in_bytes;
+	}
+
+/***************** End of Implementation Section ******************/
+
+
+}; //end namespace CogaDB
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <core/base_column.hpp>
+#include <core/bit_operations.hpp>
+#include <vector>
+#include <algorithm>
+
+namespace CoGaDB{
+
+	/*
+
+	A vector of unsigned integers, where every element is stored with the
+	same (minimal) number of bits. The elements are packed densely into
+	64 bit words, so an element may span two words.
+
+	Pushing or setting a value that does not fit into the current bit width
+	widens the whole vector once (repacking), so the width always is
+	bitsRequired(largest value stored so far).
+
+	Blocks of 64 elements occupy exactly 'width' words. Sequential access
+	should use unpack() or select(), which decode a whole block at once
+	with a kernel that is specialized for each bit width.
+
+	*/
+	class BitPackedVector {
+	public:
+		BitPackedVector() : width(1), length(0), words() {}
+
+		unsigned int size() const { return this->length; }
+		bool empty() const { return this->length == 0; }
+		unsigned int bitWidth() const { return this->width; }
+
+		unsigned int get(unsigned int i) const {
+			const boost::uint64_t bit = boost::uint64_t(i) * this->width;
+			const unsigned int word = (unsigned int)(bit >> 6);
+			const unsigned int shift = (unsigned int)(bit & 63);
+			boost::uint64_t value = this->words[word] >> shift;
+			if (shift + this->width > 64)
+				value |= this->words[word + 1] << (64 - shift);
+			return (unsigned int)(value & this->mask());
+		}
+
+		void set(unsigned int i, unsigned int value) {
+			if (value > this->mask())
+				this->repack(bitsRequired(value));
+			this->write(i, value);
+		}
+
+		void push_back(unsigned int value) {
+			if (value > this->mask())
+				this->repack(bitsRequired(value));
+			this->length++;
+			this->words.resize(this->wordsFor(this->length), 0);
+			this->write(this->length - 1, value);
+		}
+
+		void erase(unsigned int i) {
+			for (unsigned int j = i; j + 1 < this->length; j++)
+				this->write(j, this->get(j + 1));
+			this->length--;
+			this->words.resize(this->wordsFor(this->length));
+		}
+
+		//replaces the elements [first, last) by the elements of values, the elements behind last are moved
+		void replace(unsigned int first, unsigned int last, const BitPackedVector& values) {
+			if (values.width > this->width)
+				this->repack(values.width);
+			const unsigned int old_length = this->length;
+			const unsigned int new_length = old_length - (last - first) + values.length;
+			if (new_length > old_length) {
+				this->words.resize(this->wordsFor(new_length), 0);
+				for (unsigned int j = old_length; j > last; j--)
+					this->write(j - 1 + (new_length - old_length), this->get(j - 1));
+			}
+			else {
+				for (unsigned int j = last; j < old_length; j++)
+					this->write(j - (old_length - new_length), this->get(j));
+			}
+			for (unsigned int k = 0; k < values.length; k++)
+				this->write(first + k, values.get(k));
+			this->length = new_length;
+			this->words.resize(this->wordsFor(new_length), 0);
+		}
+
+		void clear() {
+			this->words.clear();
+			this->length = 0;
+			this->width = 1;
+		}
+
+		//changes the bit width of all elements, the new width must be large enough for all values
+		void repack(unsigned int new_width) {
+			BitPackedVector packed;
+			packed.width = new_width;
+			packed.length = this->length;
+			packed.words.resize(packed.wordsFor(this->length), 0);
+
+			unsigned int buffer[64];
+			for (unsigned int i = 0; i < this->length; i += 64) {
+				unsigned int n = std::min(64u, this->length - i);
+				this->unpack(i, n, buffer);
+				for (unsigned int k = 0; k < n; k++)
+					packed.write(i + k, buffer[k]);
+			}
+			this->words.swap(packed.words);
+			this->width = new_width;
+		}
+
+		//decodes the elements [begin, begin+count) into out
+		void unpack(unsigned int begin, unsigned int count, unsigned int* out) const {
+			const unsigned int end = begin + count;
+			while (begin < end && begin % 64 != 0)
+				*out++ = this->get(begin++);
+
+			const UnpackFunction kernel = unpackKernel(this->width);
+			while (begin + 64 <= end) {
+				kernel(&this->words[(begin / 64) * this->width], out);
+				out += 64;
+				begin += 64;
+			}
+
+			while (begin < end)
+				*out++ = this->get(begin++);
+		}
+
+		/*! \brief appends the positions in [begin, end) to result, where predicate(element) is true
+		 *  \details the elements are decoded block wise and the comparison loop is free of branches */
+		template<typename Predicate>
+		void select(unsigned int begin, unsigned int end, Predicate predicate, PositionList& result) const {
+			unsigned int buffer[64];
+			for (unsigned int i = begin; i < end; i += 64) {
+				const unsigned int n = std::min(64u, end - i);
+				this->unpack(i, n, buffer);
+
+				size_t pos = result.size();
+				result.resize(pos + n);
+				for (unsigned int k = 0; k < n; k++) {
+					result[pos] = i + k;
+					pos += predicate(buffer[k]) ? 1 : 0;
+				}
+				result.resize(pos);
+			}
+		}
+
+		unsigned int getSizeinBytes() const {
+			return this->words.capacity()*sizeof(boost::uint64_t);
+		}
+
+		template<class Archive>
+		void serialize(Archive & ar, const unsigned int)
+		{
+			ar & this->width;
+			ar & this->length;
+			ar & this->words;
+		}
+
+	private:
+		unsigned int width;
+		unsigned int length;
+		std::vector<boost::uint64_t> words;
+
+		typedef void(*UnpackFunction)(const boost::uint64_t*, unsigned int*);
+
+		boost::uint64_t mask() const {
+			return (boost::uint64_t(1) << this->width) - 1;
+		}
+
+		unsigned int wordsFor(unsigned int elements) const {
+			return (unsigned int)((boost::uint64_t(elements) * this->width + 63) / 64);
+		}
+
+		void write(unsigned int i, unsigned int value) {
+			const boost::uint64_t bit = boost::uint64_t(i) * this->width;
+			const unsigned int word = (unsigned int)(bit >> 6);
+			const unsigned int shift = (unsigned int)(bit & 63);
+			this->words[word] = (this->words[word] & ~(this->mask() << shift)) | (boost::uint64_t(value) << shift);
+			if (shift + this->width > 64) {
+				const unsigned int high = 64 - shift;
+				this->words[word + 1] = (this->words[word + 1] & ~(this->mask() >> high)) | (boost::uint64_t(value) >> high);
+			}
+		}
+
+		//decodes one block of 64 elements, the width is known at compile time so the loop is fully unrolled
+		template<unsigned int W>
+		static void unpackBlock(const boost::uint64_t* in, unsigned int* out) {
+			const boost::uint64_t mask = (boost::uint64_t(1) << W) - 1;
+			for (unsigned int i = 0; i < 64; i++) {
+				const unsigned int bit = i * W;
+				const unsigned int shift = bit & 63;
+				boost::uint64_t value = in[bit >> 6] >> shift;
+				if (shift + W > 64)
+					value |= in[(bit >> 6) + 1] << (64 - shift);
+				out[i] = (unsigned int)(value & mask);
+			}
+		}
+
+		static UnpackFunction unpackKernel(unsigned int width) {
+			static const UnpackFunction kernels[] = { 0,
+				unpackBlock<1>, unpackBlock<2>, unpackBlock<3>, unpackBlock<4>,
+				unpackBlock<5>, unpackBlock<6>, unpackBlock<7>, unpackBlock<8>,
+				unpackBlock<9>, unpackBlock<10>, unpackBlock<11>, unpackBlock<12>,
+				unpackBlock<13>, unpackBlock<14>, unpackBlock<15>, unpackBlock<16>,
+				unpackBlock<17>, unpackBlock<18>, unpackBlock<19>, unpackBlock<20>,
+				unpackBlock<21>, unpackBlock<22>, unpackBlock<23>, unpackBlock<24>,
+				unpackBlock<25>, unpackBlock<26>, unpackBlock<27>, unpackBlock<28>,
+				unpackBlock<29>, unpackBlock<30>, unpackBlock<31>, unpackBlock<32> };
+			return kernels[width];
+		}
+	};
+
+}; //end namespace CogaDB
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <core/bit_operations.hpp>
+#include <vector>
+#include <algorithm>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace CoGaDB{
+
+	/*
+
+	A plain bitmap, the bits are stored in 64 bit words. Bit i is bit
+	(i % 64) of word (i / 64). The bitmap does not know its length in bits,
+	only the number of words, the unused bits of the last word stay zero.
+
+	*/
+	class Bitmap {
+	public:
+		Bitmap() : words() {}
+		//creates a bitmap with at least 'bits' zero bits
+		explicit Bitmap(unsigned int bits) : words((bits + 63) / 64, 0) {}
+
+		unsigned int wordCount() const { return (unsigned int)this->words.size(); }
+		boost::uint64_t word(unsigned int w) const { return this->words[w]; }
+
+		void set(unsigned int pos) { this->words[pos >> 6] |= boost::uint64_t(1) << (pos & 63); }
+		void reset(unsigned int pos) { this->words[pos >> 6] &= ~(boost::uint64_t(1) << (pos & 63)); }
+		bool test(unsigned int pos) const { return ((this->words[pos >> 6] >> (pos & 63)) & 1) != 0; }
+
+		//appends a zero word
+		void addWord() { this->words.push_back(0); }
+		void clear() { this->words.clear(); }
+
+		bool isZero(unsigned int w) const { return this->words[w] == 0; }
+		bool isZero() const {
+			for (unsigned int w = 0; w < this->words.size(); w++) {
+				if (this->words[w] != 0)
+					return false;
+			}
+			return true;
+		}
+
+		//number of set bits
+		unsigned int count() const {
+			unsigned int result = 0;
+			for (unsigned int w = 0; w < this->words.size(); w++)
+				result += popcount64(this->words[w]);
+			return result;
+		}
+
+		unsigned int getSizeinBytes() const {
+			return (unsigned int)(this->words.capacity()*sizeof(boost::uint64_t));
+		}
+
+		template<class Archive>
+		void serialize(Archive & ar, const unsigned int)
+		{
+			ar & this->words;
+		}
+
+	private:
+		std::vector<boost::uint64_t> words;
+	};
+
+	/*
+
+	A bitmap with a rank directory: the number of set bits of every block
+	of 8 words (512 bits) is kept in a Fenwick tree, so
+
+	rank(pos)  - the number of set bits in front of pos
+	select(k)  - the position of the k-th set bit (counted from 0)
+
+	cost O(log(blocks)) tree accesses plus at most 8 popcounts. Setting or
+	resetting a bit updates O(log(blocks)) nodes of the tree, appending a
+	block computes its node from two prefix sums. The tree is only changed
+	by set(), reset() and addWord(), so concurrent readers are safe. It is
+	not serialized, but rebuilt after loading.
+
+	Node j (counted from 1) of the tree holds the number of set bits of the
+	blocks [j - lowbit(j), j), lowbit(j) being the lowest set bit of j.
+
+	*/
+	class RankSelectBitmap {
+	public:
+		RankSelectBitmap() : bits(), tree() {}
+
+		unsigned int wordCount() const { return this->bits.wordCount(); }
+		boost::uint64_t word(unsigned int w) const { return this->bits.word(w); }
+		bool test(unsigned int pos) const { return this->bits.test(pos); }
+		bool isZero(unsigned int w) const { return this->bits.isZero(w); }
+
+		void set(unsigned int pos) {
+			if (this->bits.test(pos))
+				return;
+			this->bits.set(pos);
+			for (unsigned int j = pos / BLOCK_BITS + 1; j <= this->tree.size(); j += lowbit(j))
+				this->tree[j - 1]++;
+		}
+
+		void reset(unsigned int pos) {
+			if (!this->bits.test(pos))
+				return;
+			this->bits.reset(pos);
+			for (unsigned int j = pos / BLOCK_BITS + 1; j <= this->tree.size(); j += lowbit(j))
+				this->tree[j - 1]--;
+		}
+
+		void addWord() {
+			this->bits.addWord();
+			if ((this->bits.wordCount() - 1) % BLOCK_WORDS == 0) { //the new word starts an empty block
+				const unsigned int j = (unsigned int)this->tree.size() + 1;
+				this->tree.push_back(this->prefix(j - 1) - this->prefix(j - lowbit(j)));
+			}
+		}
+
+		void clear() {
+			this->bits.clear();
+			this->tree.clear();
+		}
+
+		//number of set bits
+		unsigned int count() const {
+			return this->prefix((unsigned int)this->tree.size());
+		}
+
+		//number of set bits in [0, pos), pos has to be smaller than wordCount()*64
+		unsigned int rank(unsigned int pos) const {
+			const unsigned int w = pos >> 6;
+			unsigned int result = this->prefix(w / BLOCK_WORDS);
+			for (unsigned int i = (w / BLOCK_WORDS) * BLOCK_WORDS; i < w; i++)
+				result += popcount64(this->bits.word(i));
+			if ((pos & 63) != 0)
+				result += popcount64(this->bits.word(w) << (64 - (pos & 63)));
+			return result;
+		}
+
+		//position of the k-th set bit, k has to be smaller than count()
+		unsigned int select(unsigned int k) const {
+			//descends the tree to the last block, in front of which at most k bits are set
+			unsigned int block = 0;
+			unsigned int step = 1;
+			while (step * 2 <= this->tree.size())
+				step *= 2;
+			for (; step > 0; step /= 2) {
+				if (block + step <= this->tree.size() && this->tree[block + step - 1] <= k) {
+					block += step;
+					k -= this->tree[block - 1];
+				}
+			}
+			unsigned int w = block * BLOCK_WORDS;
+			for (unsigned int ones = popcount64(this->bits.word(w)); k >= ones; ones = popcount64(this->bits.word(w))) {
+				k -= ones;
+				w++;
+			}
+			//clear the k lowest set bits, the position of the remaining lowest bit is the answer
+			boost::uint64_t word = this->bits.word(w);
+			for (; k > 0; k--)
+				word &= word - 1;
+			return w * 64 + countTrailingZeros64(word);
+		}
+
+		unsigned int getSizeinBytes() const {
+			return (unsigned int)(this->bits.getSizeinBytes() + this->tree.capacity()*sizeof(unsigned int));
+		}
+
+		template<class Archive>
+		void save(Archive & ar, const unsigned int) const
+		{
+			ar & this->bits;
+		}
+
+		template<class Archive>
+		void load(Archive & ar, const unsigned int)
+		{
+			ar & this->bits;
+			this->rebuildTree();
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+	private:
+		static const unsigned int BLOCK_WORDS = 8;
+		static const unsigned int BLOCK_BITS = BLOCK_WORDS * 64;
+
+		Bitmap bits;
+		//Fenwick tree over the number of set bits of the blocks
+		std::vector<unsigned int> tree;
+
+		static unsigned int lowbit(unsigned int j) { return j & (~j + 1); }
+
+		//number of set bits in the first 'blocks' blocks
+		unsigned int prefix(unsigned int blocks) const {
+			unsigned int result = 0;
+			for (unsigned int j = blocks; j > 0; j -= lowbit(j))
+				result += this->tree[j - 1];
+			return result;
+		}
+
+		//counts the bits of every block and adds each node to its parent, O(blocks)
+		void rebuildTree() {
+			this->tree.assign((this->bits.wordCount() + BLOCK_WORDS - 1) / BLOCK_WORDS, 0);
+			for (unsigned int w = 0; w < this->bits.wordCount(); w++)
+				this->tree[w / BLOCK_WORDS] += popcount64(this->bits.word(w));
+			for (unsigned int j = 1; j <= this->tree.size(); j++) {
+				if (j + lowbit(j) <= this->tree.size())
+					this->tree[j + lowbit(j) - 1] += this->tree[j - 1];
+			}
+		}
+	};
+
+}; //end namespace CogaDB
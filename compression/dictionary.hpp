@@ -0,0 +1,285 @@
+#pragma once
+
+#include <core/base_column.hpp>
+#include <core/string_heap.hpp>
+#include <vector>
+#include <map>
+#include <string>
+#include <fstream>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+
+namespace CoGaDB{
+
+	/*
+	
+	Storage of the dictionary values: a std::vector for fixed size types,
+	a StringHeap for strings. ValueRef is what reading a value returns,
+	the hash index is keyed by it.
+
+	*/
+template<typename T>
+struct DictionaryTraits {
+	typedef std::vector<T> Values;
+	typedef const T& ValueRef;
+
+	static void set(Values& values, unsigned int i, ValueRef value) { values[i] = value; }
+	static T& materialize(Values& values, unsigned int i) { return values[i]; }
+	static unsigned int getSizeinBytes(const Values& values) { return values.capacity()*sizeof(T); }
+};
+
+template<>
+struct DictionaryTraits<std::string> {
+	typedef StringHeap Values;
+	typedef StringRef ValueRef;
+
+	static void set(Values& values, unsigned int i, ValueRef value) { values.set(i, value); }
+	static std::string& materialize(Values& values, unsigned int i) { return values.materialize(i); }
+	static unsigned int getSizeinBytes(const Values& values) { return values.getSizeinBytes(); }
+};
+
+//hash index value -> DictID
+template<typename T>
+class DictionaryIndex {
+public:
+	typedef typename DictionaryTraits<T>::Values Values;
+	typedef typename DictionaryTraits<T>::ValueRef ValueRef;
+
+	explicit DictionaryIndex(const Values* values_) : values(values_), index() {}
+	//copies the index of other, which refers to values_ afterwards (a copy of the values of other)
+	DictionaryIndex(const DictionaryIndex& other, const Values* values_) : values(values_), index(other.index) {}
+
+	inline int find(ValueRef value) const {
+		typename boost::unordered_map<T, unsigned int>::const_iterator it = this->index.find(value);
+		if (it == this->index.end())
+			return -1;
+		return it->second;
+	}
+	void insert(unsigned int dictID) { this->index[(*this->values)[dictID]] = dictID; }
+	void erase(unsigned int dictID) { this->index.erase((*this->values)[dictID]); }
+	void clear() { this->index.clear(); }
+	void rehash(unsigned int buckets) { this->index.rehash(buckets); }
+
+	unsigned int getSizeinBytes() const {
+		return this->index.size()*(sizeof(T) + sizeof(unsigned int) + sizeof(void*))+ //Hash index nodes
+			this->index.bucket_count()*sizeof(void*); //Hash index buckets
+	}
+
+private:
+	//a copy would refer to the values of the original, see the constructor above
+	DictionaryIndex(const DictionaryIndex&);
+	DictionaryIndex& operator=(const DictionaryIndex&);
+
+	const Values* values;
+	boost::unordered_map<T, unsigned int> index;
+};
+
+/*
+The string index only stores DictIDs, the hash function and the comparison
+read the characters from the StringHeap, so no string is stored twice.
+*/
+template<>
+class DictionaryIndex<std::string> {
+public:
+	typedef StringHeap Values;
+	typedef StringRef ValueRef;
+
+	explicit DictionaryIndex(const Values* values_) : values(values_), index(0, DictIDHash(values_), DictIDEqual(values_)) {}
+	//copies the DictIDs of other, they are hashed again with the characters of values_
+	DictionaryIndex(const DictionaryIndex& other, const Values* values_)
+		: values(values_), index(other.index.begin(), other.index.end(), other.index.bucket_count(), DictIDHash(values_), DictIDEqual(values_)) {}
+
+	inline int find(ValueRef value) const {
+		boost::unordered_set<unsigned int, DictIDHash, DictIDEqual>::const_iterator it = this->index.find(value, boost::hash<StringRef>(), ValueEqual(this->values));
+		if (it == this->index.end())
+			return -1;
+		return *it;
+	}
+	void insert(unsigned int dictID) { this->index.insert(dictID); }
+	void erase(unsigned int dictID) { this->index.erase(dictID); }
+	void clear() { this->index.clear(); }
+	void rehash(unsigned int buckets) { this->index.rehash(buckets); }
+
+	unsigned int getSizeinBytes() const {
+		return this->index.size()*(sizeof(unsigned int) + sizeof(void*))+ //Hash index nodes
+			this->index.bucket_count()*sizeof(void*); //Hash index buckets
+	}
+
+private:
+	//a copy would refer to the values of the original, see the constructor above
+	DictionaryIndex(const DictionaryIndex&);
+	DictionaryIndex& operator=(const DictionaryIndex&);
+
+	struct DictIDHash {
+		const Values* values;
+		explicit DictIDHash(const Values* values_) : values(values_) {}
+		std::size_t operator() (unsigned int dictID) const { return hash_value((*values)[dictID]); }
+	};
+	struct DictIDEqual {
+		const Values* values;
+		explicit DictIDEqual(const Values* values_) : values(values_) {}
+		bool operator() (unsigned int a, unsigned int b) const { return a == b; }
+	};
+	struct ValueEqual {
+		const Values* values;
+		explicit ValueEqual(const Values* values_) : values(values_) {}
+		bool operator() (const StringRef& value, unsigned int dictID) const { return (*values)[dictID] == value; }
+	};
+
+	const Values* values;
+	boost::unordered_set<unsigned int, DictIDHash, DictIDEqual> index;
+};
+
+	/*
+
+	The dictionary of a dictionary compressed column: the values, a hash
+	index (value -> DictID) and a reference count per DictID, which tells
+	how many rows use it. A DictID nobody refers to any more is a tombstone.
+
+	A dictionary without a name is private to one column. A named
+	dictionary can be shared by several columns (see
+	DictionaryCompressedColumn::bindDictionary), their DictIDs are then
+	directly comparable. The reference counts are summed over all bound
+	columns. A shared dictionary only grows, DictIDs are never changed or
+	reused, so a column never has to be re-encoded because of another one.
+
+	Shared dictionaries are stored once per directory in the file
+	'<name>.dict'. Loading a column returns the dictionary that was already
+	stored or loaded from this file if it is still in memory, so all columns
+	loaded from one directory are bound to the same object again.
+
+	*/
+template<typename T>
+class Dictionary : public shared_pointer_namespace::enable_shared_from_this<Dictionary<T> > {
+	public:
+	typedef shared_pointer_namespace::shared_ptr<Dictionary<T> > DictionaryPtr;
+	typedef typename DictionaryTraits<T>::Values Values;
+	typedef typename DictionaryTraits<T>::ValueRef ValueRef;
+
+	explicit Dictionary(const std::string& name_ = std::string()) : name(name_), dict(), index(&dict), references(), tombstones(0), stored_file(), stored_size(0) {}
+
+	//the index refers to the values of its dictionary, so the copy is bound to the copied values
+	Dictionary(const Dictionary& other)
+		: shared_pointer_namespace::enable_shared_from_this<Dictionary<T> >(), name(other.name), dict(other.dict), index(other.index, &dict),
+		references(other.references), tombstones(other.tombstones), stored_file(), stored_size(0) {}
+
+	std::string name;
+	Values dict;
+	DictionaryIndex<T> index;
+	std::vector<unsigned int> references;
+	unsigned int tombstones;
+
+	bool shared() const { return !this->name.empty(); }
+	unsigned int size() const { return this->dict.size(); }
+
+	//Searches a value in the dictionary and return the position if existing
+	inline int lookup(ValueRef value) const {
+		return this->index.find(value);
+	}
+	//appends a new (unreferenced) value to the dictionary and returns its DictID
+	inline unsigned int add(ValueRef value) {
+		this->dict.push_back(value);
+		this->references.push_back(0);
+		this->tombstones++;
+		this->index.insert(this->dict.size() - 1);
+		return this->dict.size() - 1;
+	}
+	//changes the value of a DictID, the new value must not be in the dictionary yet
+	void replace(unsigned int dictID, ValueRef value) {
+		this->index.erase(dictID);
+		DictionaryTraits<T>::set(this->dict, dictID, value);
+		this->index.insert(dictID);
+	}
+	//returns a T& to the value of a DictID, for strings this is a materialized copy
+	T& materialize(unsigned int dictID) {
+		return DictionaryTraits<T>::materialize(this->dict, dictID);
+	}
+	//a row starts using dictID
+	inline void reference(unsigned int dictID) {
+		if (this->references[dictID]++ == 0)
+			this->tombstones--;
+	}
+	//a row stops using dictID
+	inline void release(unsigned int dictID) {
+		if (--this->references[dictID] == 0)
+			this->tombstones++;
+	}
+
+	void rebuildIndex() {
+		this->index.clear();
+		this->index.rehash(this->dict.size());
+		for (unsigned int i = 0; i < this->dict.size(); i++)
+			this->index.insert(i);
+	}
+
+	//all DictIDs are unreferenced afterwards, the columns add their references again
+	void resetReferences() {
+		this->references.assign(this->dict.size(), 0);
+		this->tombstones = this->dict.size();
+	}
+
+	unsigned int getSizeinBytes() const {
+		return DictionaryTraits<T>::getSizeinBytes(this->dict)+ //Dictionary
+			this->references.capacity()*sizeof(unsigned int)+ //Reference counts
+			this->index.getSizeinBytes(); //Hash index
+	}
+
+	/*! \brief writes a shared dictionary to '<path>/<name>.dict'
+	 *  \details the file is only written again if values were added since the last store*/
+	bool store(const std::string& path) {
+		const std::string file = path + "/" + this->name + ".dict";
+		if (file == this->stored_file && this->dict.size() == this->stored_size)
+			return true;
+
+		std::ofstream ofs(file.c_str(), std::ios_base::binary | std::ios_base::out);
+		boost::archive::binary_oarchive oa(ofs);
+		oa << this->dict;
+		ofs.flush();
+		ofs.close();
+
+		this->stored_file = file;
+		this->stored_size = this->dict.size();
+		registry()[file] = this->shared_from_this();
+		return true;
+	}
+
+	/*! \brief returns the shared dictionary 'name' stored in path
+	 *  \details if the dictionary of this file is still in memory, it is returned instead of reading the file again*/
+	static DictionaryPtr load(const std::string& path, const std::string& name) {
+		const std::string file = path + "/" + name + ".dict";
+		DictionaryPtr dictionary = registry()[file].lock();
+		if (dictionary)
+			return dictionary;
+
+		dictionary = DictionaryPtr(new Dictionary<T>(name));
+		std::ifstream ifs(file.c_str(), std::ios_base::binary | std::ios_base::in);
+		boost::archive::binary_iarchive ia(ifs);
+		ia >> dictionary->dict;
+		ifs.close();
+
+		dictionary->rebuildIndex();
+		dictionary->resetReferences();
+		dictionary->stored_file = file;
+		dictionary->stored_size = dictionary->dict.size();
+		registry()[file] = dictionary;
+		return dictionary;
+	}
+
+	private:
+	//the index refers to the values of this object
+	Dictionary& operator=(const Dictionary&);
+
+	//file and size of the last store, values are only appended to shared dictionaries
+	std::string stored_file;
+	unsigned int stored_size;
+
+	//shared dictionaries in memory, by file name
+	static std::map<std::string, shared_pointer_namespace::weak_ptr<Dictionary<T> > >& registry() {
+		static std::map<std::string, shared_pointer_namespace::weak_ptr<Dictionary<T> > > dictionaries;
+		return dictionaries;
+	}
+};
+
+}; //end namespace CogaDB
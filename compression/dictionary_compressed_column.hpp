@@ -6,7 +6,11 @@
 #pragma once
 
 #include <core/compressed_column.hpp>
+#include <compression/bit_packed_vector.hpp>
+#include <compression/dictionary.hpp>
 #include <vector>
+#include <algorithm>
+#include <functional>
 
 namespace CoGaDB{
 	
@@ -14,19 +18,66 @@ namespace CoGaDB{
 	/*
 	
 	This struct holds the column and the respective dictionary.
-	It is also serialized for easier load and store.
+
+	The DictIDs in the column are bit packed: each one uses
+	ceil(log2(dictionary size)) bits, the vector widens itself when the
+	dictionary grows past a power of two.
+
+	The dictionary is private to the column unless the column was bound to
+	a shared dictionary. Copying the struct copies a private dictionary and
+	shares a shared one, the rows of a column bound to a shared dictionary
+	hold references on it until they are destroyed.
 	
 	*/
 template<typename T>
 struct DictColumn {
-	std::vector<T> dict;
-	std::vector<unsigned int> column;
+	typedef typename Dictionary<T>::DictionaryPtr DictionaryPtr;
+
+	DictionaryPtr dictionary;
+	BitPackedVector column;
+
+	DictColumn() : dictionary(new Dictionary<T>()), column() {}
+
+	DictColumn(const DictColumn& other)
+		: dictionary(other.dictionary->shared() ? other.dictionary : DictionaryPtr(new Dictionary<T>(*other.dictionary))), column(other.column) {
+		if (this->dictionary->shared())
+			this->referenceAll();
+	}
+
+	~DictColumn() {
+		if (this->dictionary->shared())
+			this->releaseAll();
+	}
+
+	DictColumn& operator=(DictColumn other) {
+		this->swap(other);
+		return *this;
+	}
 
-	template<class Archive>
-	void serialize(Archive & ar, const unsigned int version)
-	{
-		ar & dict;
-		ar & column;
+	void swap(DictColumn& other) {
+		this->dictionary.swap(other.dictionary);
+		std::swap(this->column, other.column);
+	}
+
+	//adds the references of all rows to the dictionary
+	void referenceAll() {
+		unsigned int buffer[64];
+		for (unsigned int i = 0; i < column.size(); i += 64) {
+			unsigned int n = std::min(64u, column.size() - i);
+			column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				dictionary->reference(buffer[k]);
+		}
+	}
+
+	void releaseAll() {
+		unsigned int buffer[64];
+		for (unsigned int i = 0; i < column.size(); i += 64) {
+			unsigned int n = std::min(64u, column.size() - i);
+			column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				dictionary->release(buffer[k]);
+		}
 	}
 };
 
@@ -34,6 +85,8 @@ struct DictColumn {
 template<class T>
 class DictionaryCompressedColumn : public CompressedColumn<T>{
 	public:
+	typedef typename Dictionary<T>::DictionaryPtr DictionaryPtr;
+	typedef typename Dictionary<T>::ValueRef ValueRef;
 
 	DictionaryCompressedColumn(const std::string& name, AttributeType db_type);
 	virtual ~DictionaryCompressedColumn();
@@ -61,24 +114,126 @@ class DictionaryCompressedColumn : public CompressedColumn<T>{
 	virtual bool load(const std::string& path);
 	
 	virtual T& operator[](const int index);
+	virtual void decode(TID begin, TID end, T* out);
+
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const PositionListPtr parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads);
+	virtual const PositionListPairPtr hash_join(ColumnPtr join_column);
+	virtual const PositionListPtr sort(SortOrder order);
+
+	//removes all tombstones from the dictionary and remaps the DictIDs in one sweep, shared dictionaries are never compacted
+	virtual void compact();
+
+	/*! \brief re-encodes the column with a shared (named) dictionary
+	 *  \details the DictIDs of all columns bound to the same dictionary are directly comparable
+	 *  \return false if the dictionary is not a shared one or the column can not share its dictionary*/
+	virtual bool bindDictionary(const DictionaryPtr& dictionary);
+	const DictionaryPtr& getDictionary() const;
 
-private:
+protected:
 	DictColumn<T> values;
+
+	struct DictIDEquals {
+		unsigned int dictID;
+		DictIDEquals(unsigned int dictID_) : dictID(dictID_) {}
+		inline bool operator() (unsigned int id) const { return id == dictID; }
+	};
+
+	struct DictIDLesser {
+		unsigned int bound;
+		DictIDLesser(unsigned int bound_) : bound(bound_) {}
+		inline bool operator() (unsigned int id) const { return id < bound; }
+	};
+
+	struct DictIDGreaterEqual {
+		unsigned int bound;
+		DictIDGreaterEqual(unsigned int bound_) : bound(bound_) {}
+		inline bool operator() (unsigned int id) const { return id >= bound; }
+	};
+
+	struct DictIDInSet {
+		const char* qualifies;
+		DictIDInSet(const std::vector<char>& qualifies_) : qualifies(qualifies_.empty() ? 0 : &qualifies_[0]) {}
+		inline bool operator() (unsigned int id) const { return qualifies[id] != 0; }
+	};
+
+	/*
+	A filter condition translated into the DictID domain: either a single
+	DictID (EQUAL), a DictID bound (ordered dictionaries) or a lookup table
+	with one entry per DictID. NONE means no row can qualify.
+	*/
+	struct DictIDFilter {
+		enum Kind { NONE, EQUALS, LESSER_THAN, GREATER_EQUAL, TABLE };
+		Kind kind;
+		unsigned int dictID;
+		std::vector<char> table;
+		DictIDFilter() : kind(NONE), dictID(0), table() {}
+	};
+
+	//compares two DictIDs by their values
+	struct ValueOrder {
+		const typename Dictionary<T>::Values& dict;
+		ValueOrder(const typename Dictionary<T>::Values& dict_) : dict(dict_) {}
+		inline bool operator() (unsigned int i, unsigned int j) const { return dict[i] < dict[j]; }
+	};
+
+	//computes for each DictID its position in the value order
+	virtual void rankCodes(std::vector<unsigned int>& rank) const;
+	//counting sort of the TIDs by the rank of their DictID, the TIDs of rank r are tids[offsets[r], offsets[r+1])
+	void sortByRank(const std::vector<unsigned int>& rank, std::vector<unsigned int>& offsets, PositionList& tids) const;
+	virtual void groupByKey(typename ColumnBaseTyped<T>::KeyGroups& groups, unsigned int number_of_threads);
+
+	//translates a filter condition against the dictionary, this is done once per selection
+	virtual void translate(const T& value, const ValueComparator comp, DictIDFilter& filter) const;
+	//appends all TIDs in [begin, end) that fulfill the filter to result, only the DictIDs are read
+	void scan(const DictIDFilter& filter, TID begin, TID end, PositionList& result) const;
+
+	//the kernel of a morsel of parallel_selection()
+	struct FilterScan {
+		const DictionaryCompressedColumn<T>& column;
+		const DictIDFilter& filter;
+		FilterScan(const DictionaryCompressedColumn<T>& column_, const DictIDFilter& filter_) : column(column_), filter(filter_) {}
+		void operator()(TID begin, TID end, PositionList& result) const { column.scan(filter, begin, end, result); }
+	};
+
 	//Searches a value in the dictionary and return the position if existing
-	inline int lookup(T value) {
-		for (unsigned int i = 0; i < this->values.dict.size();  i++)
-			if (this->values.dict[i] == value)
-				return i;
-		return -1;
-	}
-	//counts how often a value is in the column 
-	inline unsigned int count(unsigned int dictID) {
-		unsigned int c = 0;
-		for (unsigned int i = 0; i < this->values.column.size(); i++){
-			if (dictID == this->values.column[i])
-				c++;
-		}
-		return c;
+	inline int lookup(ValueRef value) const {
+		return this->values.dictionary->lookup(value);
+	}
+	//appends a new (unreferenced) value to the dictionary and returns its DictID
+	inline unsigned int addToDictionary(const T& value) {
+		return this->values.dictionary->add(value);
+	}
+	//returns the DictID of a value, the value is added to the dictionary if necessary
+	virtual unsigned int encodeValue(const T& value) {
+		int index = this->lookup(value);
+		if (index == -1)
+			return this->addToDictionary(value);
+		return index;
+	}
+	//a row starts using dictID
+	inline void reference(unsigned int dictID) {
+		this->values.dictionary->reference(dictID);
+	}
+	//a row stops using dictID
+	inline void release(unsigned int dictID) {
+		this->values.dictionary->release(dictID);
+	}
+	//sets the DictID of a row, the old DictID is released
+	void replace(TID tid, unsigned int dictID) {
+		unsigned int old = this->values.column.get(tid);
+		if (old == dictID)
+			return;
+		this->values.column.set(tid, dictID);
+		this->reference(dictID);
+		this->release(old);
+		this->compactIfNeeded();
+	}
+	//compaction is triggered when more than half of the dictionary are tombstones
+	inline void compactIfNeeded() {
+		const Dictionary<T>& dictionary = *this->values.dictionary;
+		if (!dictionary.shared() && dictionary.tombstones > 64 && dictionary.tombstones > dictionary.dict.size() / 2)
+			this->compact();
 	}
 
 };
@@ -118,13 +273,9 @@ private:
 
 	template<class T>
 	bool DictionaryCompressedColumn<T>::insert(const T& new_value){
-		int index = this->lookup(boost::any_cast<T>(new_value));
-		if (index == -1) {
-			this->values.dict.push_back(new_value);
-			this->values.column.push_back(this->values.dict.size() - 1);
-		}
-		else
-			this->values.column.push_back(index);
+		unsigned int dictID = this->encodeValue(new_value);
+		this->values.column.push_back(dictID);
+		this->reference(dictID);
 		return true;
 	}
 
@@ -144,7 +295,7 @@ private:
 	template<class T>
 	const boost::any DictionaryCompressedColumn<T>::get(TID tid){
 		if (tid < this->values.column.size()) {
-			return boost::any(this->values.dict[this->values.column[tid]]);
+			return boost::any(T(this->values.dictionary->dict[this->values.column.get(tid)]));
 		}
 		return boost::any();
 	}
@@ -154,12 +305,12 @@ private:
 		std::cout << "| Coloumn |" << std::endl;
 		std::cout << "________________________" << std::endl;
 		for (unsigned int i = 0; i < this->values.column.size(); i++){
-			std::cout << "| " << this->values.column[i] << " |" << std::endl;
+			std::cout << "| " << this->values.column.get(i) << " |" << std::endl;
 		}
 		std::cout << "| Dictionary |" << std::endl;
 		std::cout << "________________________" << std::endl;
-		for (unsigned int i = 0; i < this->values.dict.size(); i++){
-			std::cout << "| " << i << " | " << this->values.dict[i] << " |" << std::endl;
+		for (unsigned int i = 0; i < this->values.dictionary->dict.size(); i++){
+			std::cout << "| " << i << " | " << this->values.dictionary->dict[i] << " |" << std::endl;
 		}
 	}
 	template<class T>
@@ -174,31 +325,13 @@ private:
 	template<class T>
 	bool DictionaryCompressedColumn<T>::update(TID tid, const boost::any& obj){
 		if (tid < this->values.column.size() && typeid(T) == obj.type()) {
-			int index = this->lookup(boost::any_cast<T>(obj));
-			if (index == -1) { //update value does not exist in dictinary
-				if (this->count(this->values.column[tid]) == 1) //if old value is present just once -> swap values
-					this->values.dict[this->values.column[tid]] = boost::any_cast<T>(obj);
-				else {
-					this->values.dict.push_back(boost::any_cast<T>(obj)); //if old value is present more then once -> create new dict entry
-					this->values.column[tid] = this->values.dict.size() - 1;
-				}
-			}
-			else {
-				unsigned int old = this->values.column[tid];
-
-				if (this->count(old) == 1) {
-					this->values.column[tid] = index; //update value is in dictionary -> put dictid into column
-
-					for (unsigned int i = 0; i < this->values.column.size(); i++) {
-						if (this->values.column[i] > old)
-							this->values.column[i]--;
-					}
-					this->values.dict.erase(this->values.dict.begin() + old);
-				}
-				else
-					this->values.column[tid] = index; //update value is in dictionary -> put dictid into column
-
+			const T& value = boost::any_cast<const T&>(obj);
+			unsigned int old = this->values.column.get(tid);
+			if (!this->values.dictionary->shared() && this->lookup(value) == -1 && this->values.dictionary->references[old] == 1) { //if old value is present just once -> swap values
+				this->values.dictionary->replace(old, value);
 			}
+			else //otherwise point the row to the (maybe new) dict entry
+				this->replace(tid, this->encodeValue(value));
 			return true;
 		}
 		return false;
@@ -214,39 +347,67 @@ private:
 	}
 	
 	/*
-	If a value just appears once in the column and is replaced it is removed from the
-	dictionary. If so, the DictID for all following values in the dictionary decreases by 1.
-	Ist must be corrected in the column.
+	Removing a row only decreases the reference count of its DictID. If the
+	value is not used anymore, it stays in the dictionary as a tombstone
+	until the next compaction.
 	*/
 	template<class T>
 	bool DictionaryCompressedColumn<T>::remove(TID tid){
 		if (tid < this->values.column.size()) {
-			if (this->count(this->values.column[tid]) == 1) {
-				for (unsigned int i = 0; i < this->values.column.size(); i++) {
-					if (this->values.column[i] > this->values.column[tid])
-						this->values.column[i]--;
-				}
-				this->values.dict.erase(this->values.dict.begin() + this->values.column[tid]);
-			}
-			this->values.column.erase(this->values.column.begin() + tid);
+			unsigned int dictID = this->values.column.get(tid);
+			this->values.column.erase(tid);
+			this->release(dictID);
+			this->compactIfNeeded();
 			return true;
 		}
 		return false;	
 	}
 	
+	/*
+	The column is rebuilt in one pass without the removed rows, their
+	DictIDs are released. Compaction is checked once at the end.
+	*/
 	template<class T>
 	bool DictionaryCompressedColumn<T>::remove(PositionListPtr posPtr){
-		for (unsigned int i = 0; i < posPtr->size(); i++)
-			if (!this->remove(posPtr->at(i)))
-				return false;
+		if (!posPtr)
+			return false;
+		//an empty TID list is an error, like in Column<T>::remove()
+		if (posPtr->empty())
+			return false;
+
+		PositionListPtr tids = sortedPositionList(posPtr);
+		if (tids->back() >= this->values.column.size())
+			return false;
 
+		BitPackedVector column;
+		column.repack(this->values.column.bitWidth()); //keeps the width, so the new column is never repacked
+		unsigned int buffer[64];
+		unsigned int k = 0;
+		for (unsigned int i = 0; i < this->values.column.size(); i += 64) {
+			unsigned int n = std::min(64u, this->values.column.size() - i);
+			this->values.column.unpack(i, n, buffer);
+			for (unsigned int j = 0; j < n; j++) {
+				if (k < tids->size() && (*tids)[k] == i + j) {
+					this->release(buffer[j]);
+					while (k < tids->size() && (*tids)[k] == i + j) //skip duplicate TIDs
+						k++;
+				}
+				else
+					column.push_back(buffer[j]);
+			}
+		}
+		std::swap(this->values.column, column);
+		this->compactIfNeeded();
 		return true;
 	}
 
+	//a shared dictionary stays bound, the rows just release their DictIDs
 	template<class T>
 	bool DictionaryCompressedColumn<T>::clearContent(){
-		this->values.column.clear();
-		this->values.dict.clear();
+		DictColumn<T> values;
+		if (this->values.dictionary->shared())
+			values.dictionary = this->values.dictionary;
+		this->values.swap(values);
 		return true;
 	}
 
@@ -256,9 +417,15 @@ private:
 		path += "/";
 		path += this->name_;
 
+		//a shared dictionary is written to its own file, the column only keeps its name
 		std::ofstream ofs(path.c_str(), std::ios_base::binary | std::ios_base::out);
 		boost::archive::binary_oarchive oa(ofs);
-		oa << this->values;
+		oa << this->values.dictionary->name;
+		if (this->values.dictionary->shared())
+			this->values.dictionary->store(path_);
+		else
+			oa << this->values.dictionary->dict;
+		oa << this->values.column;
 
 		ofs.flush();
 		ofs.close();
@@ -272,21 +439,366 @@ private:
 
 		std::ifstream ifs(path.c_str(), std::ios_base::binary | std::ios_base::in);
 		boost::archive::binary_iarchive ia(ifs);
-		ia >> this->values;
-
+		std::string dictionary_name;
+		ia >> dictionary_name;
+		DictColumn<T> values;
+		if (dictionary_name.empty()) {
+			ia >> values.dictionary->dict;
+			values.dictionary->rebuildIndex();
+			values.dictionary->resetReferences();
+		}
+		else
+			values.dictionary = Dictionary<T>::load(path_, dictionary_name);
+		ia >> values.column;
+		values.referenceAll();
 		ifs.close();
+
+		//the previous content releases its DictIDs when 'values' goes out of scope
+		this->values.swap(values);
 		return true;
 	}
 
 	template<class T>
 	T& DictionaryCompressedColumn<T>::operator[](const int index){
-		return this->values.dict[this->values.column[index]];
+		return this->values.dictionary->materialize(this->values.column.get(index));
+	}
+
+	//the DictIDs are unpacked block wise, every row costs one dictionary lookup
+	template<class T>
+	void DictionaryCompressedColumn<T>::decode(TID begin, TID end, T* out){
+		const BitPackedVector& column = this->values.column;
+		const typename Dictionary<T>::Values& dict = this->values.dictionary->dict;
+		unsigned int buffer[64];
+		for (TID i = begin; i < end; i += 64) {
+			unsigned int n = std::min(64u, end - i);
+			column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				*out++ = T(dict[buffer[k]]);
+		}
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::translate(const T& value, const ValueComparator comp, DictIDFilter& filter) const{
+		if (comp == EQUAL) {
+			int dictID = this->lookup(value);
+			if (dictID != -1) {
+				filter.kind = DictIDFilter::EQUALS;
+				filter.dictID = dictID;
+			}
+			return;
+		}
+		if (comp != LESSER && comp != GREATER)
+			return;
+
+		filter.kind = DictIDFilter::TABLE;
+		filter.table.resize(this->values.dictionary->dict.size());
+		for (unsigned int i = 0; i < this->values.dictionary->dict.size(); i++)
+			filter.table[i] = comp == LESSER ? this->values.dictionary->dict[i] < value : value < this->values.dictionary->dict[i];
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::scan(const DictIDFilter& filter, TID begin, TID end, PositionList& result) const{
+		const BitPackedVector& column = this->values.column;
+		switch (filter.kind) {
+		case DictIDFilter::EQUALS:
+			column.select(begin, end, DictIDEquals(filter.dictID), result);
+			break;
+		case DictIDFilter::LESSER_THAN:
+			column.select(begin, end, DictIDLesser(filter.dictID), result);
+			break;
+		case DictIDFilter::GREATER_EQUAL:
+			column.select(begin, end, DictIDGreaterEqual(filter.dictID), result);
+			break;
+		case DictIDFilter::TABLE:
+			column.select(begin, end, DictIDInSet(filter.table), result);
+			break;
+		default:
+			break;
+		}
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::rankCodes(std::vector<unsigned int>& rank) const{
+		std::vector<unsigned int> order(this->values.dictionary->dict.size());
+		for (unsigned int i = 0; i < order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), ValueOrder(this->values.dictionary->dict));
+
+		rank.resize(order.size());
+		for (unsigned int i = 0; i < order.size(); i++)
+			rank[order[i]] = i;
+	}
+
+	template<class T>
+	void DictionaryCompressedColumn<T>::sortByRank(const std::vector<unsigned int>& rank, std::vector<unsigned int>& offsets, PositionList& tids) const{
+		const BitPackedVector& column = this->values.column;
+		unsigned int buffer[64];
+		offsets.assign(rank.size() + 1, 0);
+		for (unsigned int i = 0; i < column.size(); i += 64) {
+			unsigned int n = std::min(64u, column.size() - i);
+			column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				offsets[rank[buffer[k]] + 1]++;
+		}
+		for (unsigned int r = 1; r < offsets.size(); r++)
+			offsets[r] += offsets[r - 1];
+
+		std::vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+		tids.resize(column.size());
+		for (unsigned int i = 0; i < column.size(); i += 64) {
+			unsigned int n = std::min(64u, column.size() - i);
+			column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				tids[next[rank[buffer[k]]]++] = i + k;
+		}
+	}
+
+	/*
+	The codes are grouped instead of the rows: the dictionary is ranked once
+	(O(d log d), free for an ordered dictionary) and the TIDs are counting
+	sorted by the rank of their DictID, so every used DictID becomes one
+	group and sort_merge_join() only compares d values.
+	*/
+	template<class T>
+	void DictionaryCompressedColumn<T>::groupByKey(typename ColumnBaseTyped<T>::KeyGroups& groups, unsigned int){
+		std::vector<unsigned int> rank;
+		this->rankCodes(rank);
+		std::vector<unsigned int> offsets;
+		this->sortByRank(rank, offsets, groups.tids);
+
+		std::vector<unsigned int> order(rank.size());
+		for (unsigned int i = 0; i < rank.size(); i++)
+			order[rank[i]] = i;
+		for (unsigned int r = 0; r < rank.size(); r++) {
+			if (offsets[r] != offsets[r + 1]) {
+				groups.keys.push_back(T(this->values.dictionary->dict[order[r]]));
+				groups.first.push_back(offsets[r]);
+				groups.last.push_back(offsets[r + 1]);
+			}
+		}
+	}
+
+	/*
+	Sorting in the compressed domain: the dictionary is ranked once and the
+	TIDs are counting sorted by the rank of their DictID, which is
+	O(n + d log d). A descending sort reverses the ranks, so the TIDs of
+	equal values stay in ascending order.
+	*/
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::sort(SortOrder order){
+		if (order != ASCENDING && order != DESCENDING) {
+			std::cout << "FATAL ERROR: DictionaryCompressedColumn<T>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr(new PositionList());
+		}
+
+		std::vector<unsigned int> rank;
+		this->rankCodes(rank);
+		if (order == DESCENDING) {
+			for (unsigned int i = 0; i < rank.size(); i++)
+				rank[i] = rank.size() - 1 - rank[i];
+		}
+
+		std::vector<unsigned int> offsets;
+		PositionListPtr ids(new PositionList());
+		this->sortByRank(rank, offsets, *ids);
+		return ids;
+	}
+
+	/*
+	The comparison value is translated against the dictionary once,
+	afterwards only the bit packed DictIDs are scanned.
+	*/
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		if (value_for_comparison.type() != typeid(T)) {
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+
+		DictIDFilter filter;
+		this->translate(boost::any_cast<const T&>(value_for_comparison), comp, filter);
+
+		PositionListPtr result_tids(new PositionList());
+		this->scan(filter, 0, this->values.column.size(), *result_tids);
+		return result_tids;
+	}
+
+	/*
+	The filter is translated once, the morsels only scan the DictIDs.
+	*/
+	template<class T>
+	const PositionListPtr DictionaryCompressedColumn<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		if (value_for_comparison.type() != typeid(T)) {
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+
+		DictIDFilter filter;
+		this->translate(boost::any_cast<const T&>(value_for_comparison), comp, filter);
+		return this->morselSelection(this->values.column.size(), number_of_threads, FilterScan(*this, filter));
+	}
+
+	/*
+	Joining two dictionary compressed columns works on the DictIDs only:
+	1. The (small) dictionaries are matched once, which gives a translation
+	   table from the DictIDs of the join column to our DictIDs. Columns
+	   bound to the same shared dictionary skip the matching.
+	2. Our TIDs are grouped by DictID with a counting sort, so the TIDs of
+	   a DictID can be found by direct array lookup.
+	3. The DictIDs of the join column are scanned and translated, each
+	   match emits the TIDs of the corresponding group.
+	If the join column uses another compression, the generic hash join is used.
+	*/
+	template<class T>
+	const PositionListPairPtr DictionaryCompressedColumn<T>::hash_join(ColumnPtr join_column_){
+		shared_pointer_namespace::shared_ptr<DictionaryCompressedColumn<T> > join_column;
+		if (join_column_ && join_column_->type() == typeid(T))
+			join_column = shared_pointer_namespace::dynamic_pointer_cast<DictionaryCompressedColumn<T> >(join_column_);
+		if (!join_column)
+			return ColumnBaseTyped<T>::hash_join(join_column_);
+
+		const DictColumn<T>& build = this->values;
+		const DictColumn<T>& probe = join_column->values;
+		const Dictionary<T>& build_dictionary = *build.dictionary;
+		const Dictionary<T>& probe_dictionary = *probe.dictionary;
+		const bool same_dictionary = build.dictionary == probe.dictionary;
+
+		const unsigned int NO_MATCH = (unsigned int)-1;
+		std::vector<unsigned int> translation(probe_dictionary.size(), NO_MATCH);
+		for (unsigned int i = 0; i < probe_dictionary.size(); i++) {
+			if (probe_dictionary.references[i] == 0)
+				continue;
+			int dictID = same_dictionary ? (int)i : this->lookup(probe_dictionary.dict[i]);
+			if (dictID != -1 && build_dictionary.references[dictID] != 0)
+				translation[i] = dictID;
+		}
+
+		//group our TIDs by DictID, the reference counts of a private dictionary are the group sizes
+		unsigned int buffer[64];
+		std::vector<unsigned int> offsets(build_dictionary.size() + 1, 0);
+		if (build_dictionary.shared()) { //the reference counts are summed over all bound columns
+			for (unsigned int i = 0; i < build.column.size(); i += 64) {
+				unsigned int n = std::min(64u, build.column.size() - i);
+				build.column.unpack(i, n, buffer);
+				for (unsigned int k = 0; k < n; k++)
+					offsets[buffer[k] + 1]++;
+			}
+		}
+		else
+			std::copy(build_dictionary.references.begin(), build_dictionary.references.end(), offsets.begin() + 1);
+		for (unsigned int i = 1; i < offsets.size(); i++)
+			offsets[i] += offsets[i - 1];
+
+		std::vector<TID> tids(build.column.size());
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (unsigned int i = 0; i < build.column.size(); i += 64) {
+			unsigned int n = std::min(64u, build.column.size() - i);
+			build.column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				tids[fill[buffer[k]]++] = i + k;
+		}
+
+		PositionListPairPtr join_tids(new PositionListPair());
+		join_tids->first = PositionListPtr(new PositionList());
+		join_tids->second = PositionListPtr(new PositionList());
+
+		for (unsigned int i = 0; i < probe.column.size(); i += 64) {
+			unsigned int n = std::min(64u, probe.column.size() - i);
+			probe.column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++) {
+				unsigned int dictID = translation[buffer[k]];
+				if (dictID == NO_MATCH)
+					continue;
+				for (unsigned int j = offsets[dictID]; j < offsets[dictID + 1]; j++) {
+					join_tids->first->push_back(tids[j]);
+					join_tids->second->push_back(i + k);
+				}
+			}
+		}
+		return join_tids;
+	}
+
+	/*
+	Live DictIDs keep their relative order, so an ordered dictionary stays
+	ordered. The column is re-encoded in a single pass, which also shrinks
+	the bit width of the DictIDs if possible.
+	*/
+	template<class T>
+	void DictionaryCompressedColumn<T>::compact(){
+		if (this->values.dictionary->tombstones == 0 || this->values.dictionary->shared())
+			return;
+
+		std::vector<unsigned int> new_ids(this->values.dictionary->dict.size());
+		typename Dictionary<T>::Values dict;
+		std::vector<unsigned int> references;
+		dict.reserve(this->values.dictionary->dict.size() - this->values.dictionary->tombstones);
+		references.reserve(this->values.dictionary->dict.size() - this->values.dictionary->tombstones);
+		for (unsigned int i = 0; i < this->values.dictionary->dict.size(); i++) {
+			if (this->values.dictionary->references[i] == 0)
+				continue;
+			new_ids[i] = dict.size();
+			dict.push_back(this->values.dictionary->dict[i]);
+			references.push_back(this->values.dictionary->references[i]);
+		}
+
+		BitPackedVector column;
+		unsigned int buffer[64];
+		for (unsigned int i = 0; i < this->values.column.size(); i += 64) {
+			unsigned int n = std::min(64u, this->values.column.size() - i);
+			this->values.column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++)
+				column.push_back(new_ids[buffer[k]]);
+		}
+
+		this->values.dictionary->dict.swap(dict);
+		this->values.dictionary->references.swap(references);
+		std::swap(this->values.column, column);
+		this->values.dictionary->tombstones = 0;
+		this->values.dictionary->rebuildIndex();
+	}
+
+	/*
+	The rows are decoded and encoded again with the new dictionary. The old
+	dictionary is released when the previous content goes out of scope.
+	*/
+	template<class T>
+	bool DictionaryCompressedColumn<T>::bindDictionary(const DictionaryPtr& dictionary){
+		if (!dictionary || !dictionary->shared())
+			return false;
+		if (dictionary == this->values.dictionary)
+			return true;
+
+		DictColumn<T> values;
+		values.dictionary = dictionary;
+		unsigned int buffer[64];
+		for (unsigned int i = 0; i < this->values.column.size(); i += 64) {
+			unsigned int n = std::min(64u, this->values.column.size() - i);
+			this->values.column.unpack(i, n, buffer);
+			for (unsigned int k = 0; k < n; k++) {
+				ValueRef value = this->values.dictionary->dict[buffer[k]];
+				int dictID = dictionary->lookup(value);
+				if (dictID == -1)
+					dictID = dictionary->add(value);
+				values.column.push_back(dictID);
+				dictionary->reference(dictID);
+			}
+		}
+		this->values.swap(values);
+		return true;
+	}
+
+	template<class T>
+	const typename DictionaryCompressedColumn<T>::DictionaryPtr& DictionaryCompressedColumn<T>::getDictionary() const{
+		return this->values.dictionary;
 	}
 
 	template<class T>
 	unsigned int DictionaryCompressedColumn<T>::getSizeinBytes() const throw(){
-		return this->values.dict.capacity()*sizeof(T)+ //Dictionary 
-			this->values.column.capacity()*sizeof(unsigned int); //Column
+		//a shared dictionary is accounted to every column bound to it
+		return this->values.dictionary->getSizeinBytes()+ //Dictionary
+			this->values.column.getSizeinBytes(); //Column
 	}
 
 /***************** End of Implementation Section ******************/
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <core/base_column.hpp>
+#include <core/bit_operations.hpp>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <boost/cstdint.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace CoGaDB{
+
+	/*
+
+	A compressed bitmap in the style of Roaring bitmaps: the bit positions
+	are split into chunks of 2^16 positions, a chunk is stored in a
+	container, which is keyed by the high 16 bits of the positions.
+
+	A container holds the low 16 bits of its positions either as
+
+	- array:  a sorted vector of unsigned shorts, if at most 4096 positions
+	          are set (at most 8 KB)
+	- bitmap: 1024 words of 64 bit, otherwise (always 8 KB)
+
+	Chunks without any set bit have no container, so a sparse bitmap costs
+	about 2 bytes per set bit, a dense one 1 bit per position.
+
+	AND, OR and ANDNOT combine the containers with equal keys. Two arrays
+	are merged, any other pair is combined word by word. Afterwards every
+	container is converted into the smaller representation. |= ORs another
+	bitmap into this one without copying the containers of this bitmap, so
+	ORing many bitmaps into one result does not allocate a new result for
+	every bitmap.
+
+	*/
+	class RoaringBitmap {
+	public:
+		RoaringBitmap() : containers() {}
+
+		void set(unsigned int pos) {
+			Container& container = this->findOrCreate(pos >> 16);
+			container.set((unsigned short)(pos & 0xFFFF));
+		}
+
+		void reset(unsigned int pos) {
+			const int index = this->find(pos >> 16);
+			if (index == -1)
+				return;
+			this->containers[index].reset((unsigned short)(pos & 0xFFFF));
+			if (this->containers[index].cardinality == 0)
+				this->containers.erase(this->containers.begin() + index);
+		}
+
+		bool test(unsigned int pos) const {
+			const int index = this->find(pos >> 16);
+			return index != -1 && this->containers[index].test((unsigned short)(pos & 0xFFFF));
+		}
+
+		//returns the 64 bits [64*w, 64*w+64)
+		boost::uint64_t word(unsigned int w) const {
+			const int index = this->find(w >> 10);
+			if (index == -1)
+				return 0;
+			return this->containers[index].word(w & 1023);
+		}
+
+		bool isZero() const { return this->containers.empty(); }
+		bool isZero(unsigned int w) const { return this->word(w) == 0; }
+
+		//number of set bits
+		unsigned int count() const {
+			unsigned int result = 0;
+			for (unsigned int i = 0; i < this->containers.size(); i++)
+				result += this->containers[i].cardinality;
+			return result;
+		}
+
+		void clear() { this->containers.clear(); }
+
+		//calls visitor(pos) for every set bit in ascending order
+		template<typename Visitor>
+		void visit(Visitor& visitor) const {
+			for (unsigned int i = 0; i < this->containers.size(); i++)
+				this->containers[i].visit(visitor);
+		}
+
+		//returns the set bits in ascending order, e.g., the TIDs of a selection result
+		PositionListPtr toPositionList() const {
+			PositionListPtr result(new PositionList());
+			result->reserve(this->count());
+			PositionCollector collector(*result);
+			this->visit(collector);
+			return result;
+		}
+
+		RoaringBitmap operator&(const RoaringBitmap& other) const { return combine(*this, other, AND); }
+		RoaringBitmap operator|(const RoaringBitmap& other) const { return combine(*this, other, OR); }
+		//bits, which are set in this bitmap but not in other
+		RoaringBitmap andNot(const RoaringBitmap& other) const { return combine(*this, other, ANDNOT); }
+
+		RoaringBitmap& operator|=(const RoaringBitmap& other) {
+			unsigned int i = 0;
+			for (unsigned int j = 0; j < other.containers.size(); j++) {
+				const Container& container = other.containers[j];
+				while (i < this->containers.size() && this->containers[i].key < container.key)
+					i++;
+				if (i < this->containers.size() && this->containers[i].key == container.key)
+					this->containers[i].unite(container);
+				else
+					this->containers.insert(this->containers.begin() + i, container);
+				i++;
+			}
+			return *this;
+		}
+
+		unsigned int getSizeinBytes() const {
+			unsigned int size_in_bytes = (unsigned int)(this->containers.capacity()*sizeof(Container));
+			for (unsigned int i = 0; i < this->containers.size(); i++)
+				size_in_bytes += this->containers[i].getSizeinBytes();
+			return size_in_bytes;
+		}
+
+		template<class Archive>
+		void serialize(Archive & ar, const unsigned int)
+		{
+			ar & this->containers;
+		}
+
+	private:
+		static const unsigned int ARRAY_LIMIT = 4096;
+		static const unsigned int CONTAINER_WORDS = 1024;
+
+		enum Operation { AND, OR, ANDNOT };
+
+		struct Container {
+			unsigned int key;
+			unsigned int cardinality;
+			std::vector<unsigned short> array;
+			std::vector<boost::uint64_t> bitmap;
+
+			Container() : key(0), cardinality(0), array(), bitmap() {}
+			explicit Container(unsigned int key_) : key(key_), cardinality(0), array(), bitmap() {}
+
+			bool isBitmap() const { return !this->bitmap.empty(); }
+
+			void set(unsigned short low) {
+				if (this->isBitmap()) {
+					const boost::uint64_t bit = boost::uint64_t(1) << (low & 63);
+					if ((this->bitmap[low >> 6] & bit) == 0) {
+						this->bitmap[low >> 6] |= bit;
+						this->cardinality++;
+					}
+					return;
+				}
+				if (this->array.empty() || this->array.back() < low) //appending is the common case
+					this->array.push_back(low);
+				else {
+					std::vector<unsigned short>::iterator it = std::lower_bound(this->array.begin(), this->array.end(), low);
+					if (*it == low)
+						return;
+					this->array.insert(it, low);
+				}
+				this->cardinality++;
+				if (this->cardinality > ARRAY_LIMIT)
+					this->toBitmap();
+			}
+
+			void reset(unsigned short low) {
+				if (this->isBitmap()) {
+					const boost::uint64_t bit = boost::uint64_t(1) << (low & 63);
+					if ((this->bitmap[low >> 6] & bit) != 0) {
+						this->bitmap[low >> 6] &= ~bit;
+						this->cardinality--;
+						if (this->cardinality <= ARRAY_LIMIT)
+							this->toArray();
+					}
+					return;
+				}
+				std::vector<unsigned short>::iterator it = std::lower_bound(this->array.begin(), this->array.end(), low);
+				if (it != this->array.end() && *it == low) {
+					this->array.erase(it);
+					this->cardinality--;
+				}
+			}
+
+			bool test(unsigned short low) const {
+				if (this->isBitmap())
+					return ((this->bitmap[low >> 6] >> (low & 63)) & 1) != 0;
+				return std::binary_search(this->array.begin(), this->array.end(), low);
+			}
+
+			boost::uint64_t word(unsigned int w) const {
+				if (this->isBitmap())
+					return this->bitmap[w];
+				boost::uint64_t result = 0;
+				std::vector<unsigned short>::const_iterator it = std::lower_bound(this->array.begin(), this->array.end(), (unsigned short)(w * 64));
+				for (; it != this->array.end() && *it < (w + 1) * 64; ++it)
+					result |= boost::uint64_t(1) << (*it & 63);
+				return result;
+			}
+
+			//adds the positions of other (with the same key) to this container
+			void unite(const Container& other) {
+				if (!this->isBitmap() && !other.isBitmap()) {
+					std::vector<unsigned short> positions;
+					positions.reserve(this->array.size() + other.array.size());
+					std::set_union(this->array.begin(), this->array.end(), other.array.begin(), other.array.end(), std::back_inserter(positions));
+					this->array.swap(positions);
+					this->cardinality = (unsigned int)this->array.size();
+					if (this->cardinality > ARRAY_LIMIT)
+						this->toBitmap();
+					return;
+				}
+				if (!this->isBitmap())
+					this->toBitmap();
+				if (!other.isBitmap()) {
+					for (unsigned int i = 0; i < other.array.size(); i++)
+						this->set(other.array[i]);
+					return;
+				}
+				this->cardinality = 0;
+				for (unsigned int w = 0; w < CONTAINER_WORDS; w++) {
+					this->bitmap[w] |= other.bitmap[w];
+					this->cardinality += popcount64(this->bitmap[w]);
+				}
+			}
+
+			//writes the positions of the container into 1024 words
+			void toWords(std::vector<boost::uint64_t>& words) const {
+				if (this->isBitmap()) {
+					words = this->bitmap;
+					return;
+				}
+				words.assign(CONTAINER_WORDS, 0);
+				for (unsigned int i = 0; i < this->array.size(); i++)
+					words[this->array[i] >> 6] |= boost::uint64_t(1) << (this->array[i] & 63);
+			}
+
+			void toBitmap() {
+				this->toWords(this->bitmap);
+				std::vector<unsigned short>().swap(this->array);
+			}
+
+			void toArray() {
+				std::vector<unsigned short> positions;
+				positions.reserve(this->cardinality);
+				for (unsigned int w = 0; w < this->bitmap.size(); w++) {
+					for (boost::uint64_t bits = this->bitmap[w]; bits != 0; bits &= bits - 1)
+						positions.push_back((unsigned short)(w * 64 + countTrailingZeros64(bits)));
+				}
+				this->array.swap(positions);
+				std::vector<boost::uint64_t>().swap(this->bitmap);
+			}
+
+			template<typename Visitor>
+			void visit(Visitor& visitor) const {
+				const unsigned int base = this->key << 16;
+				if (!this->isBitmap()) {
+					for (unsigned int i = 0; i < this->array.size(); i++)
+						visitor(base + this->array[i]);
+					return;
+				}
+				for (unsigned int w = 0; w < this->bitmap.size(); w++) {
+					for (boost::uint64_t bits = this->bitmap[w]; bits != 0; bits &= bits - 1)
+						visitor(base + w * 64 + countTrailingZeros64(bits));
+				}
+			}
+
+			unsigned int getSizeinBytes() const {
+				return (unsigned int)(this->array.capacity()*sizeof(unsigned short) + this->bitmap.capacity()*sizeof(boost::uint64_t));
+			}
+
+			template<class Archive>
+			void serialize(Archive & ar, const unsigned int)
+			{
+				ar & this->key;
+				ar & this->cardinality;
+				ar & this->array;
+				ar & this->bitmap;
+			}
+		};
+
+		//containers sorted by key
+		std::vector<Container> containers;
+
+		struct KeyLesser {
+			inline bool operator() (const Container& container, unsigned int key) const { return container.key < key; }
+		};
+
+		//returns the index of the container of key or -1
+		int find(unsigned int key) const {
+			if (!this->containers.empty() && this->containers.back().key == key) //appending is the common case
+				return (int)this->containers.size() - 1;
+			std::vector<Container>::const_iterator it = std::lower_bound(this->containers.begin(), this->containers.end(), key, KeyLesser());
+			if (it == this->containers.end() || it->key != key)
+				return -1;
+			return (int)(it - this->containers.begin());
+		}
+
+		Container& findOrCreate(unsigned int key) {
+			if (this->containers.empty() || this->containers.back().key < key) {
+				this->containers.push_back(Container(key));
+				return this->containers.back();
+			}
+			std::vector<Container>::iterator it = std::lower_bound(this->containers.begin(), this->containers.end(), key, KeyLesser());
+			if (it == this->containers.end() || it->key != key)
+				it = this->containers.insert(it, Container(key));
+			return *it;
+		}
+
+		struct PositionCollector {
+			PositionList& positions;
+			explicit PositionCollector(PositionList& positions_) : positions(positions_) {}
+			void operator() (unsigned int pos) { positions.push_back(pos); }
+		};
+
+		//combines two containers with the same key, the result may be empty
+		static Container combine(const Container& a, const Container& b, Operation op) {
+			Container result(a.key);
+			if (!a.isBitmap() && !b.isBitmap()) {
+				if (op == AND)
+					std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result.array));
+				else if (op == OR)
+					std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result.array));
+				else
+					std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), std::back_inserter(result.array));
+				result.cardinality = (unsigned int)result.array.size();
+				if (result.cardinality > ARRAY_LIMIT)
+					result.toBitmap();
+				return result;
+			}
+
+			std::vector<boost::uint64_t> words_a, words_b;
+			a.toWords(words_a);
+			b.toWords(words_b);
+			result.bitmap.resize(CONTAINER_WORDS);
+			for (unsigned int w = 0; w < CONTAINER_WORDS; w++) {
+				if (op == AND)
+					result.bitmap[w] = words_a[w] & words_b[w];
+				else if (op == OR)
+					result.bitmap[w] = words_a[w] | words_b[w];
+				else
+					result.bitmap[w] = words_a[w] & ~words_b[w];
+				result.cardinality += popcount64(result.bitmap[w]);
+			}
+			if (result.cardinality <= ARRAY_LIMIT)
+				result.toArray();
+			return result;
+		}
+
+		//merges the containers of both bitmaps by key
+		static RoaringBitmap combine(const RoaringBitmap& a, const RoaringBitmap& b, Operation op) {
+			RoaringBitmap result;
+			unsigned int i = 0, j = 0;
+			while (i < a.containers.size() || j < b.containers.size()) {
+				if (j == b.containers.size() || (i < a.containers.size() && a.containers[i].key < b.containers[j].key)) {
+					if (op != AND) //only in a
+						result.containers.push_back(a.containers[i]);
+					i++;
+				}
+				else if (i == a.containers.size() || b.containers[j].key < a.containers[i].key) {
+					if (op == OR) //only in b
+						result.containers.push_back(b.containers[j]);
+					j++;
+				}
+				else {
+					Container container = combine(a.containers[i++], b.containers[j++], op);
+					if (container.cardinality > 0)
+						result.containers.push_back(container);
+				}
+			}
+			return result;
+		}
+	};
+
+}; //end namespace CogaDB
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <compression/dictionary_compressed_column.hpp>
+#include <algorithm>
+#include <boost/iterator/counting_iterator.hpp>
+
+namespace CoGaDB{
+
+	/*
+
+	Order preserving variant of the dictionary compression.
+
+	The dictionary is split in two parts: the sorted area [0, sorted_size)
+	holds strictly ascending values, so their DictIDs compare the same way
+	as the values do. Behind it lies a small unsorted delta area.
+
+	A new value that is greater than all values in the sorted area (and no
+	delta exists yet) is appended to the sorted area, so ascending loads
+	never touch the delta. Any other new value is appended to the delta
+	area. Once the delta grows beyond 'delta_limit()' the dictionary is
+	reorganized: all values are sorted once and the column is re-encoded
+	in a single sweep. The bulk insert adds all new values of a batch to
+	the delta first and reorganizes once.
+
+	Range predicates and sort() work on the DictIDs. As long as a delta
+	area exists, range predicates use a lookup table over all DictIDs and
+	sort() ranks the delta DictIDs first, so reads never have to re-encode
+	the column.
+
+	Values that are no longer used stay in place as tombstones, so they
+	keep the order. compact() drops them without changing the order.
+
+	*/
+template<class T>
+class SortedDictionaryCompressedColumn : public DictionaryCompressedColumn<T>{
+	public:
+
+	SortedDictionaryCompressedColumn(const std::string& name, AttributeType db_type);
+	virtual ~SortedDictionaryCompressedColumn();
+
+	using DictionaryCompressedColumn<T>::insert;
+	template <typename InputIterator>
+	bool insert(InputIterator first, InputIterator last);
+
+	using DictionaryCompressedColumn<T>::update;
+	virtual bool update(TID tid, const boost::any& new_value);
+	virtual bool clearContent();
+
+	virtual const ColumnPtr copy() const;
+	virtual bool load(const std::string& path);
+
+	//the DictIDs change on every reorganization, so the dictionary can not be shared
+	virtual bool bindDictionary(const typename DictionaryCompressedColumn<T>::DictionaryPtr& dictionary);
+
+	//sorts the whole dictionary and re-encodes the column, afterwards the delta area is empty
+	void reorganize();
+	virtual void compact();
+
+protected:
+	//returns the DictID of a value, new values are added to the sorted or delta area
+	virtual unsigned int encodeValue(const T& value);
+	virtual void translate(const T& value, const ValueComparator comp, typename DictionaryCompressedColumn<T>::DictIDFilter& filter) const;
+	//only the delta area is sorted, without delta the DictIDs are their own ranks, so sort() is O(n + d)
+	virtual void rankCodes(std::vector<unsigned int>& rank) const;
+
+private:
+	unsigned int sorted_size;
+
+	typedef typename Dictionary<T>::Values Values;
+
+	//compares a DictID with a value, for binary searches over the sorted area
+	struct DictIDValueComparator {
+		const Values& dict;
+		DictIDValueComparator(const Values& dict_) : dict(dict_) {}
+		inline bool operator() (unsigned int i, const T& value) const { return dict[i] < value; }
+		inline bool operator() (const T& value, unsigned int i) const { return value < dict[i]; }
+	};
+
+	unsigned int delta_limit() const {
+		return std::max(64u, sorted_size / 16);
+	}
+};
+
+
+/***************** Start of Implementation Section ******************/
+
+
+	template<class T>
+	SortedDictionaryCompressedColumn<T>::SortedDictionaryCompressedColumn(const std::string& name, AttributeType db_type) : DictionaryCompressedColumn<T>(name, db_type), sorted_size(0){
+
+	}
+
+	template<class T>
+	SortedDictionaryCompressedColumn<T>::~SortedDictionaryCompressedColumn(){
+
+	}
+
+	template<class T>
+	unsigned int SortedDictionaryCompressedColumn<T>::encodeValue(const T& value){
+		int index = this->lookup(value);
+		if (index != -1)
+			return index;
+
+		unsigned int dictID = this->addToDictionary(value);
+		if (dictID == this->sorted_size && (this->sorted_size == 0 || this->values.dictionary->dict[this->sorted_size - 1] < value))
+			this->sorted_size++; //value extends the sorted area
+		else if (this->values.dictionary->dict.size() - this->sorted_size > this->delta_limit()) {
+			this->reorganize();
+			dictID = this->lookup(value);
+		}
+		return dictID;
+	}
+
+	/*
+	Sorts all dictionary values once and builds a translation table from the
+	old to the new DictIDs, which is applied to the column in one pass.
+	*/
+	template<class T>
+	void SortedDictionaryCompressedColumn<T>::reorganize(){
+		if (this->sorted_size == this->values.dictionary->dict.size())
+			return;
+
+		std::vector<unsigned int> rank;
+		this->rankCodes(rank);
+
+		std::vector<unsigned int> order(rank.size());
+		for (unsigned int i = 0; i < rank.size(); i++)
+			order[rank[i]] = i;
+
+		Values dict;
+		std::vector<unsigned int> references(rank.size());
+		dict.reserve(rank.size());
+		for (unsigned int i = 0; i < order.size(); i++) {
+			dict.push_back(this->values.dictionary->dict[order[i]]);
+			references[i] = this->values.dictionary->references[order[i]];
+		}
+		this->values.dictionary->dict.swap(dict);
+		this->values.dictionary->references.swap(references);
+
+		for (unsigned int i = 0; i < this->values.column.size(); i++)
+			this->values.column.set(i, rank[this->values.column.get(i)]);
+
+		this->values.dictionary->rebuildIndex();
+		this->sorted_size = this->values.dictionary->dict.size();
+	}
+
+	template<class T>
+	void SortedDictionaryCompressedColumn<T>::rankCodes(std::vector<unsigned int>& rank) const{
+		const Values& dict = this->values.dictionary->dict;
+		rank.resize(dict.size());
+		if (this->sorted_size == dict.size()) {
+			for (unsigned int i = 0; i < rank.size(); i++)
+				rank[i] = i;
+			return;
+		}
+
+		//sort the delta area and merge it with the (already sorted) sorted area
+		std::vector<unsigned int> delta;
+		for (unsigned int i = this->sorted_size; i < dict.size(); i++)
+			delta.push_back(i);
+		std::sort(delta.begin(), delta.end(), typename DictionaryCompressedColumn<T>::ValueOrder(dict));
+
+		unsigned int s = 0, d = 0, pos = 0;
+		while (s < this->sorted_size || d < delta.size()) {
+			if (d == delta.size() || (s < this->sorted_size && dict[s] < dict[delta[d]]))
+				rank[s++] = pos++;
+			else
+				rank[delta[d++]] = pos++;
+		}
+	}
+
+	//compaction keeps the relative order, only the size of the sorted area shrinks
+	template<class T>
+	void SortedDictionaryCompressedColumn<T>::compact(){
+		unsigned int live_sorted = 0;
+		for (unsigned int i = 0; i < this->sorted_size; i++)
+			live_sorted += this->values.dictionary->references[i] != 0 ? 1 : 0;
+
+		DictionaryCompressedColumn<T>::compact();
+		this->sorted_size = live_sorted;
+	}
+
+	/*
+	Bulk build: all values of the batch that are not yet in the dictionary
+	are added first, the dictionary is sorted once and afterwards the batch
+	is encoded with the final DictIDs.
+	*/
+	template <typename T>
+	template <typename InputIterator>
+	bool SortedDictionaryCompressedColumn<T>::insert(InputIterator first, InputIterator last){
+		if (!(first < last))
+			return false;
+
+		for (InputIterator it = first; it != last; it++) {
+			if (this->lookup(*it) == -1)
+				this->addToDictionary(*it);
+		}
+		this->reorganize();
+
+		for (InputIterator it = first; it != last; it++) {
+			unsigned int dictID = this->lookup(*it);
+			this->values.column.push_back(dictID);
+			this->reference(dictID);
+		}
+		return true;
+	}
+
+	template<class T>
+	bool SortedDictionaryCompressedColumn<T>::update(TID tid, const boost::any& obj){
+		if (tid < this->values.column.size() && typeid(T) == obj.type()) {
+			//replace() reads the old DictID afterwards, encodeValue() may have reorganized the dictionary
+			this->replace(tid, this->encodeValue(boost::any_cast<T>(obj)));
+			return true;
+		}
+		return false;
+	}
+
+	template<class T>
+	bool SortedDictionaryCompressedColumn<T>::clearContent(){
+		this->sorted_size = 0;
+		return DictionaryCompressedColumn<T>::clearContent();
+	}
+
+	template<class T>
+	const ColumnPtr SortedDictionaryCompressedColumn<T>::copy() const{
+		return ColumnPtr(new SortedDictionaryCompressedColumn(*this));
+	}
+
+	//the longest strictly ascending prefix of the stored dictionary is a valid sorted area
+	template<class T>
+	bool SortedDictionaryCompressedColumn<T>::load(const std::string& path){
+		if (!DictionaryCompressedColumn<T>::load(path))
+			return false;
+
+		this->sorted_size = this->values.dictionary->dict.empty() ? 0 : 1;
+		while (this->sorted_size < this->values.dictionary->dict.size()
+			&& this->values.dictionary->dict[this->sorted_size - 1] < this->values.dictionary->dict[this->sorted_size])
+			this->sorted_size++;
+		return true;
+	}
+
+	template<class T>
+	bool SortedDictionaryCompressedColumn<T>::bindDictionary(const typename DictionaryCompressedColumn<T>::DictionaryPtr&){
+		return false;
+	}
+
+	/*
+	Without a delta area a range predicate becomes a single DictID bound.
+	Otherwise the generic lookup table over all DictIDs is used.
+	*/
+	template<class T>
+	void SortedDictionaryCompressedColumn<T>::translate(const T& value, const ValueComparator comp, typename DictionaryCompressedColumn<T>::DictIDFilter& filter) const{
+		typedef typename DictionaryCompressedColumn<T>::DictIDFilter DictIDFilter;
+		const Values& dict = this->values.dictionary->dict;
+		if ((comp != LESSER && comp != GREATER) || this->sorted_size != dict.size()) {
+			DictionaryCompressedColumn<T>::translate(value, comp, filter);
+			return;
+		}
+
+		if (comp == LESSER) { //first DictID, that does not qualify any more
+			filter.kind = DictIDFilter::LESSER_THAN;
+			filter.dictID = *std::lower_bound(boost::counting_iterator<unsigned int>(0), boost::counting_iterator<unsigned int>(dict.size()), value, DictIDValueComparator(dict));
+		}
+		else { //first DictID, that qualifies
+			filter.kind = DictIDFilter::GREATER_EQUAL;
+			filter.dictID = *std::upper_bound(boost::counting_iterator<unsigned int>(0), boost::counting_iterator<unsigned int>(dict.size()), value, DictIDValueComparator(dict));
+		}
+	}
+
+/***************** End of Implementation Section ******************/
+
+
+
+}; //end namespace CogaDB
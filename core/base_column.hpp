@@ -2,6 +2,7 @@
 #pragma once
 //STL includes
 #include <typeinfo>
+#include <algorithm>
 //boost includes
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
@@ -22,6 +23,16 @@ typedef std::pair<PositionListPtr,PositionListPtr> PositionListPair;
 /* \brief a PositionListPairPtr is a a references counted smart pointer to a PositionListPair object*/
 typedef shared_pointer_namespace::shared_ptr<PositionListPair> PositionListPairPtr;
 
+/* \brief returns the TIDs of a position list in ascending order
+ *  \details the list itself is returned if it is sorted already, otherwise a sorted copy*/
+inline PositionListPtr sortedPositionList(PositionListPtr tids){
+	if (!tids || std::is_sorted(tids->begin(), tids->end()))
+		return tids;
+	PositionListPtr sorted_tids(new PositionList(*tids));
+	std::sort(sorted_tids->begin(), sorted_tids->end());
+	return sorted_tids;
+}
+
 class Table; //forward declaration
 
 /*!
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <boost/cstdint.hpp>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace CoGaDB{
+
+/*! \brief returns the number of set bits in a 64 bit word*/
+inline unsigned int popcount64(boost::uint64_t word){
+#ifdef _MSC_VER
+	return (unsigned int)__popcnt64(word);
+#else
+	return (unsigned int)__builtin_popcountll(word);
+#endif
+}
+
+/*! \brief returns the position of the lowest set bit of a 64 bit word
+ *  \details the result is undefined for word==0*/
+inline unsigned int countTrailingZeros64(boost::uint64_t word){
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return (unsigned int)index;
+#else
+	return (unsigned int)__builtin_ctzll(word);
+#endif
+}
+
+/*! \brief returns the number of bits required to represent value, at least 1*/
+inline unsigned int bitsRequired(boost::uint64_t value){
+	unsigned int bits = 1;
+	while (bits < 64 && (value >> bits) != 0)
+		bits++;
+	return bits;
+}
+
+/*! \brief mixes the bits of a hash value (the finalizer of MurmurHash3), so every bit of the result depends on all input bits
+ *  \details boost::hash is the identity for integers, so its bits are no good partitioning or slot key by themselves*/
+inline boost::uint64_t mixHash64(boost::uint64_t hash){
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+}; //end namespace CogaDB
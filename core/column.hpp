@@ -41,9 +41,16 @@ class Column : public ColumnBaseTyped<T>{
 	virtual bool isCompressed() const  throw();	
 	
 	virtual T& operator[](const int index);
+	virtual void decode(TID begin, TID end, T* out);
+	virtual bool encode(TID begin, TID end, const T* values);
+
+	virtual const PositionListPtr sort(SortOrder order);
 
 	std::vector<T>& getContent();
 
+	protected:
+	virtual void selectionKernel(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result);
+
 	private:
 
 		struct Type_TID_Comparator {
@@ -279,19 +286,56 @@ class Column : public ColumnBaseTyped<T>{
 	}
 
 	template<class T>
-	unsigned int Column<T>::getSizeinBytes() const throw(){
-			return values_.capacity()*sizeof(T);
+	void Column<T>::decode(TID begin, TID end, T* out){
+		std::copy(values_.begin() + begin, values_.begin() + end, out);
+	}
+
+	template<class T>
+	bool Column<T>::encode(TID begin, TID end, const T* values){
+		std::copy(values, values + (end - begin), values_.begin() + begin);
+		return true;
+	}
+
+	//sorts the TIDs by keys read directly from values_, without a (value, TID) copy
+	template<class T>
+	const PositionListPtr Column<T>::sort(SortOrder order){
+		if(order!=ASCENDING && order!=DESCENDING){
+			std::cout << "FATAL ERROR: Column<T>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr(new PositionList());
+		}
+		return SortEngine<T>::sort(values_, order, ThreadPool::global().getNumberOfWorkers() + 1);
 	}
 
-	//total template specialization
-	template<>
-	inline unsigned int Column<std::string>::getSizeinBytes() const throw(){
-		unsigned int size_in_bytes=0;
-		for(unsigned int i=0;i<values_.size();++i){
-			size_in_bytes+=values_[i].capacity();
+	/*
+	The comparison loops are free of branches: every TID is written to the
+	result and the write position only advances if the value qualifies.
+	*/
+	template<class T>
+	void Column<T>::selectionKernel(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result){
+		size_t pos = result.size();
+		result.resize(pos + (end - begin));
+		if(comp==EQUAL){
+			for(TID i=begin;i<end;i++){
+				result[pos]=i;
+				pos += values_[i]==value ? 1 : 0;
+			}
+		}else if(comp==LESSER){
+			for(TID i=begin;i<end;i++){
+				result[pos]=i;
+				pos += values_[i]<value ? 1 : 0;
+			}
+		}else if(comp==GREATER){
+			for(TID i=begin;i<end;i++){
+				result[pos]=i;
+				pos += values_[i]>value ? 1 : 0;
+			}
 		}
-		//return values_.size()*sizeof(T);
-		return size_in_bytes;
+		result.resize(pos);
+	}
+
+	template<class T>
+	unsigned int Column<T>::getSizeinBytes() const throw(){
+			return values_.capacity()*sizeof(T);
 	}
 
 /***************** End of Implementation Section ******************/
@@ -301,3 +345,5 @@ class Column : public ColumnBaseTyped<T>{
 
 }; //end namespace CogaDB
 
+//VARCHAR columns store their values in a string heap
+#include <core/string_column.hpp>
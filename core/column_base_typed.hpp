@@ -2,13 +2,16 @@
 #pragma once
 
 #include <core/base_column.hpp>
+#include <core/thread_pool.hpp>
+#include <core/parallel_sort.hpp>
+#include <core/radix_hash_join.hpp>
+#include <core/sort_engine.hpp>
 #include <iostream>
 
 #include <utility>
 #include <functional>
 #include <algorithm>
 
-#include <boost/unordered_map.hpp>
 #include <boost/any.hpp>
 
 //#include <core/column.hpp>
@@ -91,7 +94,91 @@ class ColumnBaseTyped : public ColumnBase{
 	 * \return a reference to the value at position index
 	 * */
 	virtual T& operator[](const int index) = 0;
+	/*! \brief writes the values of the rows [begin, end) to out[0], ..., out[end-begin-1]
+	 *  \details The generic operators read the columns with this method, VECTOR_SIZE rows at a time, instead of calling
+	 *  operator[] for every row. The default uses operator[], encodings override it to decode a whole range at once.*/
+	virtual void decode(TID begin, TID end, T* out);
+	/*! \brief overwrites the rows [begin, end) with values[0], ..., values[end-begin-1]
+	 *  \details The counterpart of decode(), the generic arithmetic operators write their results back with it. The
+	 *  default calls update() for every row, so the encoding keeps its dictionary, runs or bitmaps consistent.
+	 *  \return false if a row could not be written*/
+	virtual bool encode(TID begin, TID end, const T* values);
 	inline bool operator==(ColumnBaseTyped<T>& column);
+
+	protected:
+	/*! \brief the rows of a column grouped by value in ascending value order, the input of sort_merge_join()
+	 *  \details Group i holds rows with the value keys[i], neighbouring groups may have the same value. If tids is empty,
+	 *  the group consists of the TIDs [first[i], last[i]), otherwise of the TIDs tids[first[i]], ..., tids[last[i]-1].*/
+	struct KeyGroups {
+		std::vector<T> keys;
+		std::vector<TID> first;
+		std::vector<TID> last;
+		PositionList tids;
+		KeyGroups() : keys(), first(), last(), tids() {}
+	};
+
+	/*! \brief groups the rows by value, see KeyGroups
+	 *  \details The default sorts (value, TID) pairs, encodings override it to group their runs or codes instead of rows.*/
+	virtual void groupByKey(KeyGroups& groups, unsigned int number_of_threads);
+
+	/*! \brief appends the TIDs in [begin, end), whose values fulfill the comparison, in ascending order to result
+	 *  \details This is the kernel of selection() and of every morsel of parallel_selection(). The default reads the values
+	 *  with operator[], encodings override it to compare their own representation. It is called concurrently for
+	 *  disjoint TID ranges, so it must not modify the column.*/
+	virtual void selectionKernel(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result);
+
+	/*! \brief calls kernel(begin, end, result) for every morsel of [0, number_of_rows) on the global thread pool
+	 *  \return the results of all morsels in TID order*/
+	template<typename Kernel>
+	static const PositionListPtr morselSelection(TID number_of_rows, unsigned int number_of_threads, const Kernel& kernel);
+
+	//rows per decode() call of the generic operators, small enough that a vector of values stays in the L1 cache
+	static const TID VECTOR_SIZE = 1024;
+
+	//decodes the whole column into values
+	void decodeColumn(std::vector<T>& values);
+
+	//applies column[i] = operation(column[i], other[i]) to every row, both columns are decoded and this column is encoded vector by vector
+	template<typename Operation>
+	bool applyColumn(ColumnPtr other, Operation operation);
+
+	//applies column[i] = operation(column[i], value) to every row, vector by vector like applyColumn()
+	template<typename Operation>
+	bool applyValue(const T& value, Operation operation);
+
+	private:
+	//rows per morsel, a multiple of 64 and of VECTOR_SIZE, so bit packed encodings decode whole blocks
+	static const TID MORSEL_SIZE = 16384;
+
+	struct SelectionKernel {
+		ColumnBaseTyped<T>& column;
+		const T& value;
+		const ValueComparator comp;
+		SelectionKernel(ColumnBaseTyped<T>& column_, const T& value_, const ValueComparator comp_) : column(column_), value(value_), comp(comp_) {}
+		void operator()(TID begin, TID end, PositionList& result) const { column.selectionKernel(value, comp, begin, end, result); }
+	};
+
+	template<typename Kernel>
+	struct MorselScan {
+		const Kernel& kernel;
+		const TID number_of_rows;
+		std::vector<PositionList>& results;
+		MorselScan(const Kernel& kernel_, TID number_of_rows_, std::vector<PositionList>& results_) : kernel(kernel_), number_of_rows(number_of_rows_), results(results_) {}
+		void operator()(unsigned int morsel) const {
+			const TID begin = morsel * MORSEL_SIZE;
+			kernel(begin, std::min(number_of_rows, begin + MORSEL_SIZE), results[morsel]);
+		}
+	};
+
+	struct MorselCopy {
+		const std::vector<PositionList>& results;
+		const std::vector<size_t>& offsets;
+		PositionList& result;
+		MorselCopy(const std::vector<PositionList>& results_, const std::vector<size_t>& offsets_, PositionList& result_) : results(results_), offsets(offsets_), result(result_) {}
+		void operator()(unsigned int morsel) const {
+			std::copy(results[morsel].begin(), results[morsel].end(), result.begin() + offsets[morsel]);
+		}
+	};
 };
 
 
@@ -111,44 +198,97 @@ const std::type_info& ColumnBaseTyped<T>::type() const throw(){
 }
 
 template<class T>
-const PositionListPtr ColumnBaseTyped<T>::sort(SortOrder order){
-
-	PositionListPtr ids = PositionListPtr( new PositionList());
-		std::vector<std::pair<T,TID> > v;
-
-		for(unsigned int i=0;i<this->size();i++){
-			v.push_back (std::pair<T,TID>((*this)[i],i) );
-		}
+void ColumnBaseTyped<T>::decode(TID begin, TID end, T* out){
+		for(TID i=begin;i<end;i++)
+			*out++=(*this)[i];
+}
 
-		//TODO: change implementation, so that no copy operations are required -> use boost zip iterators!
+template<class T>
+void ColumnBaseTyped<T>::decodeColumn(std::vector<T>& values){
+		values.resize(this->size());
+		if(!values.empty())
+			this->decode(0, (TID)values.size(), &values[0]);
+}
 
-	  	if(order==ASCENDING){
-			//tbb::parallel_sort(v.begin(),v.end(),std::less_equal<std::pair<T,TID> >());
-	  		std::stable_sort(v.begin(),v.end(),std::less_equal<std::pair<T,TID> >());
-		}else if(order==DESCENDING){
-			//tbb::parallel_sort(v.begin(),v.end(),std::greater_equal<std::pair<T,TID> >());
-			std::stable_sort(v.begin(),v.end(),std::greater_equal<std::pair<T,TID> >()); 
-		}else{
+/*
+The values are decoded once and sorted by the SortEngine, see
+sort_engine.hpp.
+*/
+template<class T>
+const PositionListPtr ColumnBaseTyped<T>::sort(SortOrder order){
+		if(order!=ASCENDING && order!=DESCENDING){
 			std::cout << "FATAL ERROR: ColumnBaseTyped<T>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr(new PositionList());
 		}
 
-		for(unsigned int i=0;i<v.size();i++){
-			ids->push_back(v[i].second);
-		}
-
-		return ids;
+		std::vector<T> values;
+		this->decodeColumn(values);
+		return SortEngine<T>::sort(values, order, ThreadPool::global().getNumberOfWorkers() + 1);
 }
 
 
+/*
+Morsel driven selection: the TID range is split into morsels of
+MORSEL_SIZE rows, which the threads of the pool fetch one after another,
+so a thread that is slowed down (e.g., by a long run of matches) does not
+delay the others. Every morsel writes its own result buffer. The prefix
+sum over the buffer sizes yields the position of each buffer in the final
+result, so the buffers are copied in parallel and stay in TID order.
+*/
 template<class T>
-const PositionListPtr ColumnBaseTyped<T>::parallel_selection(const boost::any&, const ValueComparator, unsigned int){
+template<typename Kernel>
+const PositionListPtr ColumnBaseTyped<T>::morselSelection(TID number_of_rows, unsigned int number_of_threads, const Kernel& kernel){
+		const unsigned int number_of_morsels = (number_of_rows + MORSEL_SIZE - 1) / MORSEL_SIZE;
+		PositionListPtr result_tids(new PositionList());
+		if (number_of_threads <= 1 || number_of_morsels <= 1) {
+			kernel(0, number_of_rows, *result_tids);
+			return result_tids;
+		}
 
-		PositionListPtr result_tids( new PositionList());
+		ThreadPool& pool = ThreadPool::global();
+		std::vector<PositionList> results(number_of_morsels);
+		pool.run(number_of_morsels, number_of_threads, MorselScan<Kernel>(kernel, number_of_rows, results));
 
+		std::vector<size_t> offsets(number_of_morsels + 1, 0);
+		for (unsigned int m = 0; m < number_of_morsels; m++)
+			offsets[m + 1] = offsets[m] + results[m].size();
+
+		result_tids->resize(offsets.back());
+		pool.run(number_of_morsels, number_of_threads, MorselCopy(results, offsets, *result_tids));
 		return result_tids;
 }
 
+template<class T>
+const PositionListPtr ColumnBaseTyped<T>::parallel_selection(const boost::any& value_for_comparison, const ValueComparator comp, unsigned int number_of_threads){
+		if(value_for_comparison.type()!=typeid(T)){
+			std::cout << "Fatal Error!!! Typemismatch for column " << name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
 
+		const T& value = boost::any_cast<const T&>(value_for_comparison);
+		return morselSelection((TID)this->size(), number_of_threads, SelectionKernel(*this, value, comp));
+}
+
+//the rows are decoded vector by vector, the comparison loops only read the vector
+template<class T>
+void ColumnBaseTyped<T>::selectionKernel(const T& value, const ValueComparator comp, TID begin, TID end, PositionList& result){
+		std::vector<T> buffer(VECTOR_SIZE);
+		for(TID v=begin;v<end;v+=VECTOR_SIZE){
+			const TID n=std::min(end, v+VECTOR_SIZE)-v;
+			this->decode(v, v+n, &buffer[0]);
+			if(comp==EQUAL){
+				for(TID k=0;k<n;k++)
+					if(value==buffer[k]) result.push_back(v+k);
+			}else if(comp==LESSER){
+				for(TID k=0;k<n;k++)
+					if(buffer[k]<value) result.push_back(v+k);
+			}else if(comp==GREATER){
+				for(TID k=0;k<n;k++)
+					if(buffer[k]>value) result.push_back(v+k);
+			}
+		}
+}
 
 template<class T>
 const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
@@ -159,48 +299,21 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 		}
 			
 		T value = boost::any_cast<T>(value_for_comparison);
-	
-
-		PositionListPtr result_tids;
 
-				result_tids = PositionListPtr(new PositionList());
-
-				if(!quiet) std::cout << "Using CPU for Selection..." << std::endl;
-				for(TID i=0;i<this->size();i++){
-		
-					//boost::any value = column->get(i);
-					//val = values_[i];
-			
-					if(comp==EQUAL){
-					if(value==(*this)[i]){
-						//result_table->insert(this->fetchTuple(i));
-						result_tids->push_back(i);
-					}
-					}else if(comp==LESSER){
-					if((*this)[i]<value){
-						//result_table->insert(this->fetchTuple(i));
-						result_tids->push_back(i);
-					}
-					}else if(comp==GREATER){
-					if((*this)[i]>value){
-						result_tids->push_back(i);
-						//result_table->insert(this->fetchTuple(i));
-					}
-					}else{
-
-					}
-				}	
-
-	    //}
+		PositionListPtr result_tids(new PositionList());
+		if(!quiet) std::cout << "Using CPU for Selection..." << std::endl;
+		this->selectionKernel(value, comp, 0, (TID)this->size(), *result_tids);
 	    return result_tids;
 }
 
 	
+	/*
+	The keys of both columns are decoded once, afterwards they are joined by the radix partitioned hash join on the
+	global thread pool.
+	*/
 	template<class T>
 	const PositionListPairPtr ColumnBaseTyped<T>::hash_join(ColumnPtr join_column_){
 
-		typedef boost::unordered_multimap<T,TID,boost::hash<T>, std::equal_to<T> > HashTable;
-
 				if(join_column_->type()!=typeid(T)){
 					std::cout << "Fatal Error!!! Typemismatch for columns " << this->name_  << " and " << join_column_->getName() << std::endl;
 					std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
@@ -209,33 +322,54 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 				
 				shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > join_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(join_column_); //static_cast<IntColumnPtr>(column1);
 
-				PositionListPairPtr join_tids( new PositionListPair());
-				join_tids->first = PositionListPtr( new PositionList() );
-				join_tids->second = PositionListPtr( new PositionList() );
+		std::vector<T> build_keys, probe_keys;
+		this->decodeColumn(build_keys);
+		join_column->decodeColumn(probe_keys);
 
+		return RadixHashJoin<T>::join(build_keys, probe_keys, ThreadPool::global().getNumberOfWorkers() + 1);
+	}
 
-	//create hash table
-	HashTable hashtable;
-	for(unsigned int i=0;i<this->size();i++)	
-		hashtable.insert(
-								std::pair<T,TID> ((*this)[i],i)
-					);
-
-	//probe larger relation
-	for(unsigned int i=0;i<join_column->size();i++){
-		std::pair<typename HashTable::iterator, typename HashTable::iterator> range =  hashtable.equal_range((*join_column)[i]);
-		for(typename HashTable::iterator it=range.first ; it!=range.second;it++){
-			if(it->first==(*join_column)[i]){
-				join_tids->first->push_back(it->second);
-				join_tids->second->push_back(i);
-				//cout << "match! " << it->second << ", " << i << "	"  << it->first << endl;
+	/*
+	The (value, TID) pairs are sorted in parallel, unless the values already
+	are in ascending order, which the copy loop checks on the fly. Equal
+	values form one group, so the pairs are only compared during the sort.
+	*/
+	template<class T>
+	void ColumnBaseTyped<T>::groupByKey(KeyGroups& groups, unsigned int number_of_threads){
+		const TID rows = (TID)this->size();
+		std::vector<std::pair<T,TID> > pairs;
+		pairs.reserve(rows);
+		bool sorted = true;
+		std::vector<T> buffer(VECTOR_SIZE);
+		for(TID v=0;v<rows;v+=VECTOR_SIZE){
+			const TID n=std::min(rows, v+VECTOR_SIZE)-v;
+			this->decode(v, v+n, &buffer[0]);
+			for(TID i=v;i<v+n;i++){
+				pairs.push_back(std::pair<T,TID>(buffer[i-v],i));
+				if(i>0 && pairs[i].first<pairs[i-1].first) sorted=false;
 			}
 		}
+		if(!sorted)
+			parallelSort(pairs, number_of_threads);
+
+		groups.tids.resize(rows);
+		for(TID i=0;i<rows;i++){
+			if(i==0 || pairs[i-1].first<pairs[i].first){
+				if(i>0) groups.last.push_back(i);
+				groups.keys.push_back(pairs[i].first);
+				groups.first.push_back(i);
+			}
+			groups.tids[i]=pairs[i].second;
+		}
+		if(rows>0) groups.last.push_back(rows);
 	}
 
-		return join_tids;
-	}
-
+	/*
+	Both columns are grouped by value (see groupByKey()), afterwards the
+	groups are merged. All groups with the same value on both sides are
+	joined with each other, so duplicate keys on both sides produce their
+	full cross product.
+	*/
 	template<class Type>
 	const PositionListPairPtr ColumnBaseTyped<Type>::sort_merge_join(ColumnPtr join_column_){
 
@@ -251,6 +385,37 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 				join_tids->first = PositionListPtr( new PositionList() );
 				join_tids->second = PositionListPtr( new PositionList() );
 
+		const unsigned int number_of_threads = ThreadPool::global().getNumberOfWorkers() + 1;
+		KeyGroups left, right;
+		this->groupByKey(left, number_of_threads);
+		join_column->groupByKey(right, number_of_threads);
+
+		size_t i = 0, j = 0;
+		while (i < left.keys.size() && j < right.keys.size()) {
+			if (left.keys[i] < right.keys[j]) {
+				i++;
+			} else if (right.keys[j] < left.keys[i]) {
+				j++;
+			} else {
+				size_t i_end = i + 1, j_end = j + 1;
+				while (i_end < left.keys.size() && !(left.keys[i] < left.keys[i_end])) i_end++;
+				while (j_end < right.keys.size() && !(right.keys[j] < right.keys[j_end])) j_end++;
+
+				for (size_t a = i; a < i_end; a++) {
+					for (TID l = left.first[a]; l < left.last[a]; l++) {
+						const TID left_tid = left.tids.empty() ? l : left.tids[l];
+						for (size_t b = j; b < j_end; b++) {
+							for (TID r = right.first[b]; r < right.last[b]; r++) {
+								join_tids->first->push_back(left_tid);
+								join_tids->second->push_back(right.tids.empty() ? r : right.tids[r]);
+							}
+						}
+					}
+				}
+				i = i_end;
+				j = j_end;
+			}
+		}
 				return join_tids;
 	}
 
@@ -270,12 +435,21 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 				join_tids->first = PositionListPtr( new PositionList() );
 				join_tids->second = PositionListPtr( new PositionList() );
 
-		for(unsigned int i=0;i<this->size();i++){
-			for(unsigned int j=0;j<join_column->size();j++){
-				if((*this)[i]==(*join_column)[j]){
-					if(debug) std::cout << "MATCH: (" << i << "," << j << ")" << std::endl;
-					join_tids->first->push_back(i);
-					join_tids->second->push_back(j);
+		//the inner column is decoded once, the outer one vector by vector
+		std::vector<Type> inner;
+		join_column->decodeColumn(inner);
+		const TID rows = (TID)this->size();
+		std::vector<Type> buffer(VECTOR_SIZE);
+		for(TID v=0;v<rows;v+=VECTOR_SIZE){
+			const TID n=std::min(rows, v+VECTOR_SIZE)-v;
+			this->decode(v, v+n, &buffer[0]);
+			for(TID i=v;i<v+n;i++){
+				for(TID j=0;j<inner.size();j++){
+					if(buffer[i-v]==inner[j]){
+						if(debug) std::cout << "MATCH: (" << i << "," << j << ")" << std::endl;
+						join_tids->first->push_back(i);
+						join_tids->second->push_back(j);
+					}
 				}
 			}
 		}
@@ -286,25 +460,77 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 	template<class T>
 	bool ColumnBaseTyped<T>::operator==(ColumnBaseTyped<T>& column){
 	  if(this->size()!=column.size()) return false;
-	  for(unsigned int i=0;i<this->size();i++){
-			if((*this)[i]!=column[i]){ 	
+	  const TID rows=(TID)this->size();
+	  std::vector<T> left(VECTOR_SIZE), right(VECTOR_SIZE);
+	  for(TID v=0;v<rows;v+=VECTOR_SIZE){
+			const TID n=std::min(rows, v+VECTOR_SIZE)-v;
+			this->decode(v, v+n, &left[0]);
+			column.decode(v, v+n, &right[0]);
+			if(!std::equal(left.begin(), left.begin()+n, right.begin())){
 				return false;
 			}
 	  }
 	  return true;
    }
 
+	template<class T>
+	bool ColumnBaseTyped<T>::encode(TID begin, TID end, const T* values){
+		for(TID i=begin;i<end;i++){
+			if(!this->update(i, boost::any(values[i-begin])))
+				return false;
+		}
+		return true;
+	}
+
+	/*
+	The results are written back with encode() instead of operator[]. A
+	reference into a compressed column points to a shared dictionary entry
+	or to the value of a whole run, so writing to it would change other
+	rows as well and bypass the bookkeeping of the encoding.
+	*/
+	template<class T>
+	template<typename Operation>
+	bool ColumnBaseTyped<T>::applyColumn(ColumnPtr other, Operation operation){
+		if(!other) return false;
+		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<T> >(other);
+		const TID rows=(TID)std::min(this->size(), typed_column->size());
+		std::vector<T> values(VECTOR_SIZE), buffer(VECTOR_SIZE);
+		for(TID v=0;v<rows;v+=VECTOR_SIZE){
+			const TID n=std::min(rows, v+VECTOR_SIZE)-v;
+			this->decode(v, v+n, &values[0]);
+			typed_column->decode(v, v+n, &buffer[0]);
+			for(TID k=0;k<n;k++){
+				values[k]=operation(values[k], buffer[k]);
+			}
+			if(!this->encode(v, v+n, &values[0]))
+				return false;
+		}
+		return true;
+	}
+
+	template<class T>
+	template<typename Operation>
+	bool ColumnBaseTyped<T>::applyValue(const T& value, Operation operation){
+		const TID rows=(TID)this->size();
+		std::vector<T> values(VECTOR_SIZE);
+		for(TID v=0;v<rows;v+=VECTOR_SIZE){
+			const TID n=std::min(rows, v+VECTOR_SIZE)-v;
+			this->decode(v, v+n, &values[0]);
+			for(TID k=0;k<n;k++){
+				values[k]=operation(values[k], value);
+			}
+			if(!this->encode(v, v+n, &values[0]))
+				return false;
+		}
+		return true;
+	}
+
 	template<class Type>
 	bool ColumnBaseTyped<Type>::add(const boost::any& new_value){
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
 			 Type value = boost::any_cast<Type>(new_value);
-			 //std::transform(myvec.begin(), myvec.end(), myvec.begin(),
-          //bind2nd(std::plus<double>(), 1.0));
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)+=value;
-			 }
-			 return true;
+			 return this->applyValue(value, std::plus<Type>());
 		}
 		return false;
 	}
@@ -313,13 +539,7 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 			
 	template<class Type>
 	bool ColumnBaseTyped<Type>::add(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)+=typed_column->operator[](i);
-		}			
-		return true;
+		return this->applyColumn(column, std::plus<Type>());
 	}
 
 
@@ -330,23 +550,14 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
 			 Type value = boost::any_cast<Type>(new_value);
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)-=value;
-			 }
-			 return true;
+			 return this->applyValue(value, std::minus<Type>());
 		}
 		return false;
 	}
 	
 	template<class Type>
 	bool ColumnBaseTyped<Type>::minus(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)-=typed_column->operator[](i);
-		}			
-		return true;
+		return this->applyColumn(column, std::minus<Type>());
 	}	
 
 
@@ -355,23 +566,14 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 		if(new_value.empty()) return false;
 		if(typeid(Type)==new_value.type()){
 			 Type value = boost::any_cast<Type>(new_value);
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)*=value;
-			 }
-			 return true;
+			 return this->applyValue(value, std::multiplies<Type>());
 		}
 		return false;
 	}
 	
 	template<class Type>
 	bool ColumnBaseTyped<Type>::multiply(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)*=typed_column->operator[](i);
-		}			
-		return true;
+		return this->applyColumn(column, std::multiplies<Type>());
 	}
 
 
@@ -383,23 +585,14 @@ const PositionListPtr ColumnBaseTyped<T>::selection(const boost::any& value_for_
 			 Type value = boost::any_cast<Type>(new_value);
 			 //check that we do not devide by zero
 			 if(value==0) return false;
-			 for(unsigned int i=0;i<this->size();i++){
-					this->operator[](i)/=value;
-			 }
-			 return true;
+			 return this->applyValue(value, std::divides<Type>());
 		}
 		return false;
 	}
 	
 	template<class Type>
 	bool ColumnBaseTyped<Type>::division(ColumnPtr column){
-		//std::transform ( first, first+5, second, results, std::plus<int>() );		
-		shared_pointer_namespace::shared_ptr<ColumnBaseTyped<Type> > typed_column = shared_pointer_namespace::static_pointer_cast<ColumnBaseTyped<Type> >(column);
-		if(!column) return false;
-		for(unsigned int i=0;i<this->size();i++){
-			this->operator[](i)/=typed_column->operator[](i);
-		}			
-		return true;
+		return this->applyColumn(column, std::divides<Type>());
 	}
 
 	//total tempalte specializations, because numeric computations are undefined on strings 
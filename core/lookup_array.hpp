@@ -51,6 +51,8 @@ class LookupArray : public ColumnBaseTyped<T>{
 	virtual bool isCompressed() const  throw();		
 	/*! \brief returns type information of internal values*/
 	virtual T& operator[](const int index);
+	//writes every row to the referenced row of the materialized column
+	virtual bool encode(TID begin, TID end, const T* values);
 	private:
 	shared_pointer_namespace::shared_ptr<ColumnBaseTyped<T> > column_;
 	PositionListPtr tids_;
@@ -188,6 +190,15 @@ class LookupArray : public ColumnBaseTyped<T>{
 		return (*column_)[(*tids_)[index]];
 	}
 
+	template<class T>
+	bool LookupArray<T>::encode(TID begin, TID end, const T* values){
+		for(TID i=begin;i<end;i++){
+			if(!column_->encode((*tids_)[i], (*tids_)[i]+1, values++))
+				return false;
+		}
+		return true;
+	}
+
 	template<class T>
 	unsigned int LookupArray<T>::getSizeinBytes() const throw(){
 		return tids_->capacity()*sizeof(typename PositionList::value_type);
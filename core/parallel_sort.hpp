@@ -0,0 +1,94 @@
+#pragma once
+
+#include <core/thread_pool.hpp>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+namespace CoGaDB{
+
+	/*
+
+	Parallel merge sort on the global thread pool: the input is split into
+	one chunk per thread, the chunks are sorted independently and then
+	merged pairwise, which halves the number of sorted chunks per round.
+	The merges of a round run in parallel, so only the last round (a
+	single merge of two halves) is sequential. The merge rounds alternate
+	between the input and one buffer of the same size.
+
+	Small inputs are sorted with std::sort directly.
+
+	*/
+	template<typename Value, typename Compare>
+	class ParallelSort {
+	public:
+		static void sort(std::vector<Value>& values, unsigned int number_of_threads, Compare comp) {
+			const size_t size = values.size();
+			if (number_of_threads <= 1 || size < MIN_CHUNK_SIZE * number_of_threads) {
+				std::sort(values.begin(), values.end(), comp);
+				return;
+			}
+
+			std::vector<size_t> bounds(number_of_threads + 1);
+			for (unsigned int i = 0; i <= number_of_threads; i++)
+				bounds[i] = size * i / number_of_threads;
+
+			ThreadPool& pool = ThreadPool::global();
+			pool.run(number_of_threads, number_of_threads, SortChunk(values, bounds, comp));
+
+			std::vector<Value> buffer(size);
+			std::vector<Value>* source = &values;
+			std::vector<Value>* target = &buffer;
+			for (unsigned int width = 1; width < number_of_threads; width *= 2) {
+				const unsigned int merges = (number_of_threads + 2 * width - 1) / (2 * width);
+				pool.run(merges, number_of_threads, MergeChunks(*source, *target, bounds, width, comp));
+				std::swap(source, target);
+			}
+			if (source != &values)
+				values.swap(buffer);
+		}
+
+	private:
+		static const size_t MIN_CHUNK_SIZE = 4096;
+
+		struct SortChunk {
+			std::vector<Value>& values;
+			const std::vector<size_t>& bounds;
+			Compare comp;
+			SortChunk(std::vector<Value>& values_, const std::vector<size_t>& bounds_, Compare comp_) : values(values_), bounds(bounds_), comp(comp_) {}
+			void operator()(unsigned int chunk) const {
+				std::sort(values.begin() + bounds[chunk], values.begin() + bounds[chunk + 1], comp);
+			}
+		};
+
+		//merges the sorted chunks [2*width*m, 2*width*m + width) and [2*width*m + width, 2*width*(m+1)) from source into target
+		struct MergeChunks {
+			const std::vector<Value>& source;
+			std::vector<Value>& target;
+			const std::vector<size_t>& bounds;
+			const unsigned int width;
+			Compare comp;
+			MergeChunks(const std::vector<Value>& source_, std::vector<Value>& target_, const std::vector<size_t>& bounds_, unsigned int width_, Compare comp_)
+				: source(source_), target(target_), bounds(bounds_), width(width_), comp(comp_) {}
+			void operator()(unsigned int m) const {
+				const size_t chunks = bounds.size() - 1;
+				const size_t begin = bounds[std::min(chunks, size_t(2 * width * m))];
+				const size_t middle = bounds[std::min(chunks, size_t(2 * width * m + width))];
+				const size_t end = bounds[std::min(chunks, size_t(2 * width * (m + 1)))];
+				std::merge(source.begin() + begin, source.begin() + middle, source.begin() + middle, source.begin() + end, target.begin() + begin, comp);
+			}
+		};
+	};
+
+	//sorts values with the given number of threads
+	template<typename Value, typename Compare>
+	void parallelSort(std::vector<Value>& values, unsigned int number_of_threads, Compare comp) {
+		ParallelSort<Value, Compare>::sort(values, number_of_threads, comp);
+	}
+
+	template<typename Value>
+	void parallelSort(std::vector<Value>& values, unsigned int number_of_threads) {
+		ParallelSort<Value, std::less<Value> >::sort(values, number_of_threads, std::less<Value>());
+	}
+
+}; //end namespace CogaDB
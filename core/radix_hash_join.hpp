@@ -0,0 +1,286 @@
+#pragma once
+
+#include <core/base_column.hpp>
+#include <core/thread_pool.hpp>
+#include <core/bit_operations.hpp>
+#include <vector>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+
+namespace CoGaDB{
+
+	/*
+
+	Parallel radix partitioned hash join over two key arrays.
+
+	1. Partitioning: both inputs are hashed once and scattered into 2^bits
+	   partitions by the highest bits of their hash, bits is chosen so that
+	   a build partition has about PARTITION_SIZE rows. Every thread counts
+	   the partition sizes of its chunk first, a prefix sum over the counts
+	   gives each chunk its own write position in every partition, so the
+	   scatter needs no synchronisation and keeps the TID order inside a
+	   partition. A partitioned row is only its hash and TID (8 bytes).
+	   A pass writes to at most 2^MAX_PARTITION_BITS partitions, larger
+	   inputs are split by a second pass over every partition of the first.
+	2. Join: the partition pairs are joined independently on the thread
+	   pool. A partition of the build side (about PARTITION_SIZE rows) is
+	   inserted into a flat open addressing table (linear probing) that
+	   fits into the cache. Rows with equal keys share one slot and are
+	   chained by an index array, so no memory is allocated per row. The
+	   keys are only compared if the 32 bit hashes are equal.
+	3. Every partition writes its matches into its own buffers, which are
+	   copied in parallel to their final position (prefix sum over the
+	   buffer sizes).
+
+	The result contains the pairs (build TID, probe TID) ordered by
+	partition, inside a partition by probe TID and build TID.
+
+	*/
+	template<typename T>
+	class RadixHashJoin {
+	public:
+		static const PositionListPairPtr join(const std::vector<T>& build_keys, const std::vector<T>& probe_keys, unsigned int number_of_threads);
+
+	private:
+		//build rows per partition, so that a partition and its table stay in the cache
+		static const size_t PARTITION_SIZE = 4096;
+		//partitions per pass, more cost too many TLB misses during the scatter
+		static const unsigned int MAX_PARTITION_BITS = 10;
+		//joins with fewer rows are not partitioned
+		static const size_t MIN_PARALLEL_ROWS = 65536;
+
+		struct Entry {
+			unsigned int hash;
+			TID tid;
+		};
+
+		struct Partitioning {
+			std::vector<Entry> entries;
+			//partition p holds the entries [bounds[p], bounds[p+1])
+			std::vector<size_t> bounds;
+			Partitioning() : entries(), bounds() {}
+		};
+
+		//the highest bits of the hash select the partition, the lowest ones the slot of the hash table
+		static unsigned int partitionOf(unsigned int hash, unsigned int bits) {
+			return bits == 0 ? 0 : hash >> (32 - bits);
+		}
+
+		static void partition(const std::vector<T>& keys, unsigned int bits, unsigned int number_of_threads, Partitioning& result);
+		static void scatter(const std::vector<T>& keys, unsigned int bits, unsigned int number_of_threads, Partitioning& result);
+
+		//hashes the keys of a chunk and counts its partition sizes
+		struct HashChunk {
+			const std::vector<T>& keys;
+			std::vector<unsigned int>& hashes;
+			std::vector<size_t>& histograms;
+			const std::vector<size_t>& chunk_bounds;
+			const unsigned int bits;
+			HashChunk(const std::vector<T>& keys_, std::vector<unsigned int>& hashes_, std::vector<size_t>& histograms_, const std::vector<size_t>& chunk_bounds_, unsigned int bits_)
+				: keys(keys_), hashes(hashes_), histograms(histograms_), chunk_bounds(chunk_bounds_), bits(bits_) {}
+			void operator()(unsigned int chunk) const {
+				size_t* histogram = &histograms[chunk << bits];
+				boost::hash<T> hasher;
+				for (size_t i = chunk_bounds[chunk]; i < chunk_bounds[chunk + 1]; i++) {
+					hashes[i] = (unsigned int)mixHash64(hasher(keys[i]));
+					histogram[partitionOf(hashes[i], bits)]++;
+				}
+			}
+		};
+
+		//writes the entries of a chunk to the write positions of the chunk
+		struct ScatterChunk {
+			const std::vector<unsigned int>& hashes;
+			std::vector<size_t>& offsets;
+			std::vector<Entry>& entries;
+			const std::vector<size_t>& chunk_bounds;
+			const unsigned int bits;
+			ScatterChunk(const std::vector<unsigned int>& hashes_, std::vector<size_t>& offsets_, std::vector<Entry>& entries_, const std::vector<size_t>& chunk_bounds_, unsigned int bits_)
+				: hashes(hashes_), offsets(offsets_), entries(entries_), chunk_bounds(chunk_bounds_), bits(bits_) {}
+			void operator()(unsigned int chunk) const {
+				size_t* offset = &offsets[chunk << bits];
+				for (size_t i = chunk_bounds[chunk]; i < chunk_bounds[chunk + 1]; i++) {
+					Entry& entry = entries[offset[partitionOf(hashes[i], bits)]++];
+					entry.hash = hashes[i];
+					entry.tid = (TID)i;
+				}
+			}
+		};
+
+		//second pass, splits partition p of the first pass by the next bits of the hash, keeps the TID order
+		struct SplitPartition {
+			const Partitioning& first;
+			Partitioning& result;
+			const unsigned int first_bits;
+			const unsigned int bits;
+			SplitPartition(const Partitioning& first_, Partitioning& result_, unsigned int first_bits_, unsigned int bits_)
+				: first(first_), result(result_), first_bits(first_bits_), bits(bits_) {}
+			void operator()(unsigned int p) const {
+				const size_t splits = size_t(1) << (bits - first_bits);
+				const unsigned int mask = (unsigned int)splits - 1;
+				std::vector<size_t> offsets(splits, 0);
+				for (size_t i = first.bounds[p]; i < first.bounds[p + 1]; i++)
+					offsets[partitionOf(first.entries[i].hash, bits) & mask]++;
+				size_t sum = first.bounds[p];
+				for (size_t s = 0; s < splits; s++) {
+					const size_t count = offsets[s];
+					offsets[s] = sum;
+					result.bounds[p * splits + s] = sum;
+					sum += count;
+				}
+				for (size_t i = first.bounds[p]; i < first.bounds[p + 1]; i++)
+					result.entries[offsets[partitionOf(first.entries[i].hash, bits) & mask]++] = first.entries[i];
+			}
+		};
+
+		//builds the hash table of a build partition and probes it with the probe partition
+		struct JoinPartition {
+			const std::vector<T>& build_keys;
+			const std::vector<T>& probe_keys;
+			const Partitioning& build;
+			const Partitioning& probe;
+			std::vector<PositionList>& build_results;
+			std::vector<PositionList>& probe_results;
+			JoinPartition(const std::vector<T>& build_keys_, const std::vector<T>& probe_keys_, const Partitioning& build_, const Partitioning& probe_,
+				std::vector<PositionList>& build_results_, std::vector<PositionList>& probe_results_)
+				: build_keys(build_keys_), probe_keys(probe_keys_), build(build_), probe(probe_), build_results(build_results_), probe_results(probe_results_) {}
+			void operator()(unsigned int p) const;
+		};
+
+		struct CopyResults {
+			const std::vector<PositionList>& results;
+			const std::vector<size_t>& offsets;
+			PositionList& result;
+			CopyResults(const std::vector<PositionList>& results_, const std::vector<size_t>& offsets_, PositionList& result_) : results(results_), offsets(offsets_), result(result_) {}
+			void operator()(unsigned int p) const {
+				std::copy(results[p].begin(), results[p].end(), result.begin() + offsets[p]);
+			}
+		};
+	};
+
+	template<typename T>
+	void RadixHashJoin<T>::partition(const std::vector<T>& keys, unsigned int bits, unsigned int number_of_threads, Partitioning& result) {
+		if (bits <= MAX_PARTITION_BITS) {
+			scatter(keys, bits, number_of_threads, result);
+			return;
+		}
+		Partitioning first;
+		scatter(keys, MAX_PARTITION_BITS, number_of_threads, first);
+		result.entries.resize(keys.size());
+		result.bounds.resize((size_t(1) << bits) + 1);
+		result.bounds.back() = keys.size();
+		ThreadPool::global().run(1u << MAX_PARTITION_BITS, number_of_threads, SplitPartition(first, result, MAX_PARTITION_BITS, bits));
+	}
+
+	template<typename T>
+	void RadixHashJoin<T>::scatter(const std::vector<T>& keys, unsigned int bits, unsigned int number_of_threads, Partitioning& result) {
+		const size_t rows = keys.size();
+		const size_t partitions = size_t(1) << bits;
+		const unsigned int chunks = (unsigned int)std::max(size_t(1), std::min(size_t(4 * number_of_threads), rows / PARTITION_SIZE));
+		std::vector<size_t> chunk_bounds(chunks + 1);
+		for (unsigned int c = 0; c <= chunks; c++)
+			chunk_bounds[c] = rows * c / chunks;
+
+		ThreadPool& pool = ThreadPool::global();
+		std::vector<unsigned int> hashes(rows);
+		std::vector<size_t> offsets(chunks * partitions, 0);
+		pool.run(chunks, number_of_threads, HashChunk(keys, hashes, offsets, chunk_bounds, bits));
+
+		//partition by partition, chunk by chunk, so the TID order is kept inside a partition
+		result.bounds.assign(partitions + 1, 0);
+		size_t sum = 0;
+		for (size_t p = 0; p < partitions; p++) {
+			result.bounds[p] = sum;
+			for (unsigned int c = 0; c < chunks; c++) {
+				const size_t count = offsets[c * partitions + p];
+				offsets[c * partitions + p] = sum;
+				sum += count;
+			}
+		}
+		result.bounds[partitions] = sum;
+
+		result.entries.resize(rows);
+		pool.run(chunks, number_of_threads, ScatterChunk(hashes, offsets, result.entries, chunk_bounds, bits));
+	}
+
+	template<typename T>
+	void RadixHashJoin<T>::JoinPartition::operator()(unsigned int p) const {
+		const Entry* build_entries = build.entries.empty() ? 0 : &build.entries[build.bounds[p]];
+		const size_t build_size = build.bounds[p + 1] - build.bounds[p];
+		const size_t probe_begin = probe.bounds[p], probe_end = probe.bounds[p + 1];
+		if (build_size == 0 || probe_begin == probe_end)
+			return;
+
+		//at most half full, slots hold entry + 1 (0 is empty), next chains the entries with equal keys
+		size_t capacity = 16;
+		while (capacity < 2 * build_size)
+			capacity *= 2;
+		const unsigned int mask = (unsigned int)capacity - 1;
+		std::vector<unsigned int> slots(capacity, 0);
+		std::vector<unsigned int> next(build_size, 0);
+
+		//inserted backwards, so every chain is ordered by TID
+		for (size_t e = build_size; e-- > 0;) {
+			const Entry& entry = build_entries[e];
+			unsigned int s = entry.hash & mask;
+			while (slots[s] != 0) {
+				const Entry& head = build_entries[slots[s] - 1];
+				if (head.hash == entry.hash && build_keys[head.tid] == build_keys[entry.tid])
+					break;
+				s = (s + 1) & mask;
+			}
+			next[e] = slots[s];
+			slots[s] = (unsigned int)e + 1;
+		}
+
+		PositionList& build_result = build_results[p];
+		PositionList& probe_result = probe_results[p];
+		for (size_t i = probe_begin; i < probe_end; i++) {
+			const Entry& entry = probe.entries[i];
+			for (unsigned int s = entry.hash & mask; slots[s] != 0; s = (s + 1) & mask) {
+				const Entry& head = build_entries[slots[s] - 1];
+				if (head.hash != entry.hash || !(build_keys[head.tid] == probe_keys[entry.tid]))
+					continue;
+				for (unsigned int e = slots[s]; e != 0; e = next[e - 1]) {
+					build_result.push_back(build_entries[e - 1].tid);
+					probe_result.push_back(entry.tid);
+				}
+				break;
+			}
+		}
+	}
+
+	template<typename T>
+	const PositionListPairPtr RadixHashJoin<T>::join(const std::vector<T>& build_keys, const std::vector<T>& probe_keys, unsigned int number_of_threads) {
+		if (number_of_threads == 0)
+			number_of_threads = 1;
+
+		unsigned int bits = 0;
+		const bool parallel = number_of_threads > 1 && build_keys.size() + probe_keys.size() >= MIN_PARALLEL_ROWS;
+		while (bits < 2 * MAX_PARTITION_BITS
+			&& ((build_keys.size() >> bits) > PARTITION_SIZE || (parallel && (1u << bits) < 4 * number_of_threads)))
+			bits++;
+
+		Partitioning build, probe;
+		partition(build_keys, bits, number_of_threads, build);
+		partition(probe_keys, bits, number_of_threads, probe);
+
+		const unsigned int partitions = 1u << bits;
+		std::vector<PositionList> build_results(partitions), probe_results(partitions);
+		ThreadPool& pool = ThreadPool::global();
+		pool.run(partitions, number_of_threads, JoinPartition(build_keys, probe_keys, build, probe, build_results, probe_results));
+
+		std::vector<size_t> offsets(partitions + 1, 0);
+		for (unsigned int p = 0; p < partitions; p++)
+			offsets[p + 1] = offsets[p] + build_results[p].size();
+
+		PositionListPairPtr join_tids(new PositionListPair());
+		join_tids->first = PositionListPtr(new PositionList(offsets.back()));
+		join_tids->second = PositionListPtr(new PositionList(offsets.back()));
+		pool.run(partitions, number_of_threads, CopyResults(build_results, offsets, *join_tids->first));
+		pool.run(partitions, number_of_threads, CopyResults(probe_results, offsets, *join_tids->second));
+		return join_tids;
+	}
+
+}; //end namespace CogaDB
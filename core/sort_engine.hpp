@@ -0,0 +1,184 @@
+#pragma once
+
+#include <core/base_column.hpp>
+#include <core/thread_pool.hpp>
+#include <core/parallel_sort.hpp>
+#include <vector>
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+namespace CoGaDB{
+
+	/*
+
+	Sorting of a value array into a TID list. The result is stable for both
+	orders: rows with equal values keep their TID order, so every sort of
+	the same column returns the same list.
+
+	- int and float: parallel LSD radix sort over 32 bit keys, which compare
+	  as unsigned integers in the order of the values (see SortKey). For a
+	  descending sort the keys are inverted, so the sort itself never
+	  changes. Only the keys and the TIDs are moved, never the values.
+	- any other type: parallel merge sort of the TIDs, which compares the
+	  values by TID with a strict weak ordering (ties broken by TID).
+
+	*/
+
+	//maps a value to an unsigned key with the same order, radix is true if such a mapping exists
+	template<typename T>
+	struct SortKey {
+		static const bool radix = false;
+	};
+
+	template<>
+	struct SortKey<int> {
+		static const bool radix = true;
+		//flipping the sign bit moves the negative values in front of the positive ones
+		static boost::uint32_t encode(int value) { return (boost::uint32_t)value ^ 0x80000000u; }
+	};
+
+	template<>
+	struct SortKey<float> {
+		static const bool radix = true;
+		//negative floats: all bits are flipped (larger magnitude is smaller), positive floats: the sign bit is set
+		static boost::uint32_t encode(float value) {
+			if (value == 0)
+				value = 0; //-0 and 0 are equal
+			boost::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+		}
+	};
+
+	/*
+
+	LSD radix sort of 32 bit keys with their TIDs, 8 bits per pass. Every
+	pass counts the digits per chunk, a prefix sum over the counts (digit
+	by digit, chunk by chunk) gives every chunk its own write positions, so
+	the chunks are scattered in parallel and the sort stays stable. A pass
+	is skipped if all keys have the same digit, e.g., the high bytes of
+	small integers.
+
+	*/
+	class RadixSort {
+	public:
+		static void sort(std::vector<boost::uint32_t>& keys, PositionList& tids, unsigned int number_of_threads) {
+			const size_t rows = keys.size();
+			const unsigned int chunks = (unsigned int)std::max(size_t(1), std::min(size_t(4 * number_of_threads), rows / MIN_CHUNK_SIZE));
+			std::vector<size_t> chunk_bounds(chunks + 1);
+			for (unsigned int c = 0; c <= chunks; c++)
+				chunk_bounds[c] = rows * c / chunks;
+
+			ThreadPool& pool = ThreadPool::global();
+			std::vector<boost::uint32_t> key_buffer(rows);
+			PositionList tid_buffer(rows);
+			std::vector<size_t> offsets(chunks * BUCKETS);
+			for (unsigned int shift = 0; shift < 32; shift += DIGIT_BITS) {
+				std::fill(offsets.begin(), offsets.end(), 0);
+				pool.run(chunks, number_of_threads, CountDigits(keys, offsets, chunk_bounds, shift));
+
+				size_t sum = 0;
+				bool constant_digit = false;
+				for (unsigned int d = 0; d < BUCKETS; d++) {
+					const size_t begin = sum;
+					for (unsigned int c = 0; c < chunks; c++) {
+						const size_t count = offsets[c * BUCKETS + d];
+						offsets[c * BUCKETS + d] = sum;
+						sum += count;
+					}
+					constant_digit = constant_digit || sum - begin == rows;
+				}
+				if (constant_digit)
+					continue;
+
+				pool.run(chunks, number_of_threads, ScatterDigits(keys, tids, key_buffer, tid_buffer, offsets, chunk_bounds, shift));
+				keys.swap(key_buffer);
+				tids.swap(tid_buffer);
+			}
+		}
+
+	private:
+		static const unsigned int DIGIT_BITS = 8;
+		static const unsigned int BUCKETS = 1u << DIGIT_BITS;
+		static const size_t MIN_CHUNK_SIZE = 16384;
+
+		struct CountDigits {
+			const std::vector<boost::uint32_t>& keys;
+			std::vector<size_t>& offsets;
+			const std::vector<size_t>& chunk_bounds;
+			const unsigned int shift;
+			CountDigits(const std::vector<boost::uint32_t>& keys_, std::vector<size_t>& offsets_, const std::vector<size_t>& chunk_bounds_, unsigned int shift_)
+				: keys(keys_), offsets(offsets_), chunk_bounds(chunk_bounds_), shift(shift_) {}
+			void operator()(unsigned int chunk) const {
+				size_t* histogram = &offsets[chunk * BUCKETS];
+				for (size_t i = chunk_bounds[chunk]; i < chunk_bounds[chunk + 1]; i++)
+					histogram[(keys[i] >> shift) & (BUCKETS - 1)]++;
+			}
+		};
+
+		struct ScatterDigits {
+			const std::vector<boost::uint32_t>& keys;
+			const PositionList& tids;
+			std::vector<boost::uint32_t>& key_target;
+			PositionList& tid_target;
+			std::vector<size_t>& offsets;
+			const std::vector<size_t>& chunk_bounds;
+			const unsigned int shift;
+			ScatterDigits(const std::vector<boost::uint32_t>& keys_, const PositionList& tids_, std::vector<boost::uint32_t>& key_target_, PositionList& tid_target_,
+				std::vector<size_t>& offsets_, const std::vector<size_t>& chunk_bounds_, unsigned int shift_)
+				: keys(keys_), tids(tids_), key_target(key_target_), tid_target(tid_target_), offsets(offsets_), chunk_bounds(chunk_bounds_), shift(shift_) {}
+			void operator()(unsigned int chunk) const {
+				size_t* offset = &offsets[chunk * BUCKETS];
+				for (size_t i = chunk_bounds[chunk]; i < chunk_bounds[chunk + 1]; i++) {
+					const size_t pos = offset[(keys[i] >> shift) & (BUCKETS - 1)]++;
+					key_target[pos] = keys[i];
+					tid_target[pos] = tids[i];
+				}
+			}
+		};
+	};
+
+	template<typename T, bool Radix = SortKey<T>::radix>
+	struct SortEngine {
+		/*! \brief returns the TIDs of values in the given order, equal values keep their TID order*/
+		static const PositionListPtr sort(const std::vector<T>& values, SortOrder order, unsigned int number_of_threads) {
+			PositionListPtr ids(new PositionList(values.size()));
+			for (TID i = 0; i < ids->size(); i++)
+				(*ids)[i] = i;
+			if (order == DESCENDING)
+				parallelSort(*ids, number_of_threads, TIDGreater(values));
+			else
+				parallelSort(*ids, number_of_threads, TIDLesser(values));
+			return ids;
+		}
+
+	private:
+		struct TIDLesser {
+			const std::vector<T>& values;
+			TIDLesser(const std::vector<T>& values_) : values(values_) {}
+			inline bool operator() (TID i, TID j) const { return values[i] < values[j] || (!(values[j] < values[i]) && i < j); }
+		};
+
+		struct TIDGreater {
+			const std::vector<T>& values;
+			TIDGreater(const std::vector<T>& values_) : values(values_) {}
+			inline bool operator() (TID i, TID j) const { return values[j] < values[i] || (!(values[i] < values[j]) && i < j); }
+		};
+	};
+
+	template<typename T>
+	struct SortEngine<T, true> {
+		static const PositionListPtr sort(const std::vector<T>& values, SortOrder order, unsigned int number_of_threads) {
+			std::vector<boost::uint32_t> keys(values.size());
+			PositionListPtr ids(new PositionList(values.size()));
+			const boost::uint32_t invert = order == DESCENDING ? 0xFFFFFFFFu : 0;
+			for (TID i = 0; i < ids->size(); i++) {
+				keys[i] = SortKey<T>::encode(values[i]) ^ invert;
+				(*ids)[i] = i;
+			}
+			RadixSort::sort(keys, *ids, number_of_threads);
+			return ids;
+		}
+	};
+
+}; //end namespace CogaDB
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <core/column.hpp>
+#include <core/string_heap.hpp>
+#include <algorithm>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     VARCHAR column, the strings are stored in a StringHeap
+ *  \details   Selection, sort and hash join compare the strings in the heap directly.
+ *             operator[] returns a writable copy of a string, which replaces the string in the heap until it is set or a string is removed, see StringHeap::reference().
+ */
+template<>
+class Column<std::string> : public ColumnBaseTyped<std::string>{
+	public:
+	/***************** constructors and destructor *****************/
+	Column(const std::string& name, AttributeType db_type) : ColumnBaseTyped<std::string>(name, db_type), values_() {}
+	virtual ~Column() {}
+
+	virtual bool insert(const boost::any& new_value);
+	bool insert(const std::string& new_value);
+	template <typename InputIterator>
+	bool insert(InputIterator first, InputIterator last);
+
+	virtual bool update(TID tid, const boost::any& new_value);
+	virtual bool update(PositionListPtr tid, const boost::any& new_value);
+
+	virtual bool remove(TID tid);
+	//assumes tid list is sorted ascending
+	virtual bool remove(PositionListPtr tid);
+	virtual bool clearContent();
+
+	virtual const boost::any get(TID tid);
+	virtual void print() const throw();
+	virtual size_t size() const throw();
+	virtual unsigned int getSizeinBytes() const throw();
+
+	virtual const ColumnPtr copy() const;
+
+	virtual bool store(const std::string& path);
+	virtual bool load(const std::string& path);
+	virtual bool isMaterialized() const  throw();
+	virtual bool isCompressed() const  throw();
+
+	virtual const PositionListPtr sort(SortOrder order);
+	virtual const PositionListPtr selection(const boost::any& value_for_comparison, const ValueComparator comp);
+	virtual const PositionListPairPtr hash_join(ColumnPtr join_column);
+
+	virtual std::string& operator[](const int index);
+	virtual void decode(TID begin, TID end, std::string* out);
+	virtual bool encode(TID begin, TID end, const std::string* values);
+
+	StringHeap& getContent();
+
+	protected:
+	virtual void selectionKernel(const std::string& value, const ValueComparator comp, TID begin, TID end, PositionList& result);
+
+	private:
+
+	/*! values*/
+	StringHeap values_;
+};
+
+
+/***************** Start of Implementation Section ******************/
+
+
+	inline StringHeap& Column<std::string>::getContent(){
+		return values_;
+	}
+
+	inline bool Column<std::string>::insert(const boost::any& new_value){
+		if(new_value.empty()) return false;
+		if(typeid(std::string)==new_value.type()){
+			values_.push_back(boost::any_cast<const std::string&>(new_value));
+			return true;
+		}
+		return false;
+	}
+
+	inline bool Column<std::string>::insert(const std::string& new_value){
+		values_.push_back(new_value);
+		return true;
+	}
+
+	template <typename InputIterator>
+	bool Column<std::string>::insert(InputIterator first, InputIterator last){
+		for (; first != last; ++first)
+			values_.push_back(*first);
+		return true;
+	}
+
+	inline bool Column<std::string>::update(TID tid, const boost::any& new_value){
+		if(new_value.empty()) return false;
+		if(typeid(std::string)==new_value.type()){
+			values_.set(tid, boost::any_cast<const std::string&>(new_value));
+			return true;
+		}else{
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+		}
+		return false;
+	}
+
+	inline bool Column<std::string>::update(PositionListPtr tids, const boost::any& new_value){
+		if(!tids)
+			return false;
+		if(new_value.empty()) return false;
+		if(typeid(std::string)==new_value.type()){
+			const std::string& value = boost::any_cast<const std::string&>(new_value);
+			for(unsigned int i=0;i<tids->size();i++)
+				values_.set((*tids)[i], value);
+			return true;
+		}else{
+			std::cout << "Fatal Error!!! Typemismatch for column " << this->name_ << std::endl;
+		}
+		return false;
+	}
+
+	inline bool Column<std::string>::remove(TID tid){
+		values_.erase(tid);
+		return true;
+	}
+
+	inline bool Column<std::string>::remove(PositionListPtr tids){
+		if(!tids)
+			return false;
+		//test whether tid list has at least one element, if not, return with error
+		if(tids->empty())
+			return false;
+
+		//delete tuples in reverse order, otherwise the first deletion would invalidate all other tids
+		for (PositionList::reverse_iterator rit = tids->rbegin(); rit!=tids->rend(); ++rit)
+			values_.erase(*rit);
+		return true;
+	}
+
+	inline bool Column<std::string>::clearContent(){
+		values_.clear();
+		return true;
+	}
+
+	inline const boost::any Column<std::string>::get(TID tid){
+		if(tid<values_.size())
+			return boost::any(values_[tid].str());
+		else{
+			std::cout << "fatal Error!!! Invalid TID!!! Attribute: " << this->name_ << " TID: " << tid  << std::endl;
+		}
+		return boost::any();
+	}
+
+	inline void Column<std::string>::print() const throw(){
+		std::cout << "| " << this->name_ << " |" << std::endl;
+		std::cout << "________________________" << std::endl;
+		for(unsigned int i=0;i<values_.size();i++){
+			std::cout << "| " << values_[i] << " |" << std::endl;
+		}
+	}
+
+	inline size_t Column<std::string>::size() const throw(){
+		return values_.size();
+	}
+
+	inline const ColumnPtr Column<std::string>::copy() const{
+		return ColumnPtr(new Column<std::string>(*this));
+	}
+
+	inline bool Column<std::string>::store(const std::string& path_){
+		std::string path(path_);
+		path += "/";
+		path += this->name_;
+		std::ofstream outfile (path.c_str(),std::ios_base::binary | std::ios_base::out);
+		boost::archive::binary_oarchive oa(outfile);
+
+		oa << values_;
+
+		outfile.flush();
+		outfile.close();
+		return true;
+	}
+
+	inline bool Column<std::string>::load(const std::string& path_){
+		std::string path(path_);
+		path += "/";
+		path += this->name_;
+
+		std::ifstream infile (path.c_str(),std::ios_base::binary | std::ios_base::in);
+		boost::archive::binary_iarchive ia(infile);
+		ia >> values_;
+		infile.close();
+		return true;
+	}
+
+	inline bool Column<std::string>::isMaterialized() const  throw(){
+		return true;
+	}
+
+	inline bool Column<std::string>::isCompressed() const  throw(){
+		return false;
+	}
+
+	inline std::string& Column<std::string>::operator[](const int index){
+		return values_.reference(index);
+	}
+
+	inline unsigned int Column<std::string>::getSizeinBytes() const throw(){
+		return values_.getSizeinBytes();
+	}
+
+	//copies the strings out of the heap, without materializing them in the heap's cache
+	inline void Column<std::string>::decode(TID begin, TID end, std::string* out){
+		for(TID i=begin;i<end;i++){
+			const StringRef value=values_[i];
+			out++->assign(value.data, value.length);
+		}
+	}
+
+	inline bool Column<std::string>::encode(TID begin, TID end, const std::string* values){
+		for(TID i=begin;i<end;i++){
+			values_.set(i, StringRef(*values++));
+		}
+		return true;
+	}
+
+	//the strings are compared in the heap, only references to them are sorted
+	inline const PositionListPtr Column<std::string>::sort(SortOrder order){
+		if(order!=ASCENDING && order!=DESCENDING){
+			std::cout << "FATAL ERROR: Column<std::string>::sort(): Unknown Sorting Order!" << std::endl;
+			return PositionListPtr(new PositionList());
+		}
+
+		std::vector<StringRef> values(values_.size());
+		for(unsigned int i=0;i<values.size();i++)
+			values[i]=values_[i];
+		return SortEngine<StringRef>::sort(values, order, ThreadPool::global().getNumberOfWorkers() + 1);
+	}
+
+	inline const PositionListPtr Column<std::string>::selection(const boost::any& value_for_comparison, const ValueComparator comp){
+		if(value_for_comparison.type()!=typeid(std::string)){
+			std::cout << "Fatal Error!!! Typemismatch for column " << name_ << std::endl;
+			std::cout << "File: " << __FILE__ << " Line: " << __LINE__ << std::endl;
+			exit(-1);
+		}
+
+		PositionListPtr result_tids(new PositionList());
+		this->selectionKernel(boost::any_cast<const std::string&>(value_for_comparison), comp, 0, values_.size(), *result_tids);
+		return result_tids;
+	}
+
+	//compares the strings in the heap, no string is materialized, so morsels may be scanned concurrently
+	inline void Column<std::string>::selectionKernel(const std::string& value_, const ValueComparator comp, TID begin, TID end, PositionList& result){
+		const StringRef value(value_);
+		if(comp==EQUAL){
+			for(TID i=begin;i<end;i++)
+				if(values_[i]==value) result.push_back(i);
+		}else if(comp==LESSER){
+			for(TID i=begin;i<end;i++)
+				if(values_[i]<value) result.push_back(i);
+		}else if(comp==GREATER){
+			for(TID i=begin;i<end;i++)
+				if(values_[i]>value) result.push_back(i);
+		}
+	}
+
+	/*
+	The radix hash join works on references to the strings in the heaps,
+	so no string is copied. If the join column is not a VARCHAR column with
+	a heap, the generic hash join is used.
+	*/
+	inline const PositionListPairPtr Column<std::string>::hash_join(ColumnPtr join_column_){
+		shared_pointer_namespace::shared_ptr<Column<std::string> > join_column;
+		if(join_column_ && join_column_->type()==typeid(std::string))
+			join_column = shared_pointer_namespace::dynamic_pointer_cast<Column<std::string> >(join_column_);
+		if(!join_column)
+			return ColumnBaseTyped<std::string>::hash_join(join_column_);
+
+		std::vector<StringRef> build_keys(values_.size());
+		for(unsigned int i=0;i<build_keys.size();i++)
+			build_keys[i]=values_[i];
+
+		const StringHeap& probe = join_column->values_;
+		std::vector<StringRef> probe_keys(probe.size());
+		for(unsigned int i=0;i<probe_keys.size();i++)
+			probe_keys[i]=probe[i];
+
+		return RadixHashJoin<StringRef>::join(build_keys, probe_keys, ThreadPool::global().getNumberOfWorkers() + 1);
+	}
+
+/***************** End of Implementation Section ******************/
+
+}; //end namespace CogaDB
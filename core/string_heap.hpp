@@ -0,0 +1,294 @@
+#pragma once
+
+#include <core/global_definitions.hpp>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace CoGaDB{
+
+/*! \brief a read only view on the characters of a string, which are owned by someone else (e.g., a StringHeap)
+ *  \details a StringRef is invalidated by every modification of its owner*/
+struct StringRef {
+	const char* data;
+	unsigned int length;
+
+	StringRef() : data(0), length(0) {}
+	StringRef(const char* data_, unsigned int length_) : data(data_), length(length_) {}
+	StringRef(const std::string& value) : data(value.data()), length((unsigned int)value.size()) {}
+
+	std::string str() const { return std::string(this->data, this->length); }
+	explicit operator std::string() const { return this->str(); }
+
+	int compare(const StringRef& other) const {
+		const unsigned int common = std::min(this->length, other.length);
+		int result = common == 0 ? 0 : std::memcmp(this->data, other.data, common);
+		if (result != 0)
+			return result;
+		return this->length < other.length ? -1 : (this->length > other.length ? 1 : 0);
+	}
+};
+
+inline bool operator==(const StringRef& a, const StringRef& b) {
+	return a.length == b.length && (a.length == 0 || std::memcmp(a.data, b.data, a.length) == 0);
+}
+inline bool operator!=(const StringRef& a, const StringRef& b) { return !(a == b); }
+inline bool operator<(const StringRef& a, const StringRef& b) { return a.compare(b) < 0; }
+inline bool operator>(const StringRef& a, const StringRef& b) { return a.compare(b) > 0; }
+
+inline std::ostream& operator<<(std::ostream& os, const StringRef& value) {
+	return os.write(value.data, value.length);
+}
+
+//hashes the characters only, so a StringRef and the std::string it refers to have the same hash value
+inline std::size_t hash_value(const StringRef& value) {
+	return boost::hash_range(value.data, value.data + value.length);
+}
+
+	/*
+
+	Stores strings in one contiguous byte buffer instead of one heap
+	allocation per string. Every string is described by its offset into
+	the buffer and its length (8 bytes instead of a std::string object).
+
+	A string that is updated with a shorter one is overwritten in place,
+	a longer one is appended to the end of the buffer. Erased and
+	overwritten characters are garbage, the buffer is compacted once more
+	than half of it is garbage.
+
+	Code that needs a std::string& gets a materialized copy, which is
+	kept in a sparse map (index -> copy), so only the strings asked for
+	have one. The copies returned by materialize() are read only, writing
+	to them does not change the heap. The copy returned by reference() is
+	writable and replaces the characters in the buffer, so every read
+	(operator[], save()) sees what was written to it. set(i) drops the
+	copy of string i, erase() writes all writable copies back to the
+	buffer and drops every copy, like a std::vector invalidates the
+	references behind an erased element.
+
+	*/
+class StringHeap {
+public:
+	StringHeap() : bytes(), offsets(), lengths(), garbage(0), copies(), writable_copies(0) {}
+
+	unsigned int size() const { return (unsigned int)this->offsets.size(); }
+	bool empty() const { return this->offsets.empty(); }
+
+	StringRef operator[](unsigned int i) const {
+		if (this->writable_copies != 0) {
+			Copies::const_iterator it = this->copies.find(i);
+			if (it != this->copies.end() && it->second.writable)
+				return StringRef(it->second.value);
+		}
+		return this->stored(i);
+	}
+
+	//the characters of string i in the buffer, without a writable copy
+	StringRef stored(unsigned int i) const {
+		return StringRef(this->bytes.empty() ? 0 : &this->bytes[0] + this->offsets[i], this->lengths[i]);
+	}
+
+	void push_back(const StringRef& value) {
+		const unsigned int offset = this->append(value);
+		this->offsets.push_back(offset);
+		this->lengths.push_back(value.length);
+	}
+
+	void set(unsigned int i, const StringRef& value) {
+		//value may be the copy of string i itself, so it is stored before the copy is dropped
+		this->store(i, value);
+		this->dropCopy(i);
+		this->compactIfNeeded();
+	}
+
+	void erase(unsigned int i) {
+		this->dropCopy(i);
+		//the indexes of all following strings change
+		this->storeCopies();
+		this->garbage += this->lengths[i];
+		this->offsets.erase(this->offsets.begin() + i);
+		this->lengths.erase(this->lengths.begin() + i);
+		this->compactIfNeeded();
+	}
+
+	void clear() {
+		this->bytes.clear();
+		this->offsets.clear();
+		this->lengths.clear();
+		this->garbage = 0;
+		this->copies.clear();
+		this->writable_copies = 0;
+	}
+
+	void reserve(unsigned int strings) {
+		this->offsets.reserve(strings);
+		this->lengths.reserve(strings);
+	}
+
+	void swap(StringHeap& other) {
+		this->bytes.swap(other.bytes);
+		this->offsets.swap(other.offsets);
+		this->lengths.swap(other.lengths);
+		std::swap(this->garbage, other.garbage);
+		this->copies.swap(other.copies);
+		std::swap(this->writable_copies, other.writable_copies);
+	}
+
+	//returns a read only std::string copy of string i, which stays valid until string i is set or a string is erased
+	std::string& materialize(unsigned int i) {
+		Copies::iterator it = this->copies.find(i);
+		if (it == this->copies.end()) {
+			const StringRef value = this->stored(i);
+			it = this->copies.insert(Copies::value_type(i, Copy(value.str()))).first;
+		}
+		return it->second.value;
+	}
+
+	//returns a writable std::string copy of string i, which replaces the characters in the buffer
+	std::string& reference(unsigned int i) {
+		Copies::iterator it = this->copies.find(i);
+		if (it == this->copies.end()) {
+			const StringRef value = this->stored(i);
+			it = this->copies.insert(Copies::value_type(i, Copy(value.str()))).first;
+		}
+		if (!it->second.writable) {
+			it->second.writable = true;
+			this->writable_copies++;
+		}
+		return it->second.value;
+	}
+
+	unsigned int getSizeinBytes() const {
+		size_t size_in_bytes = this->bytes.capacity()+ //Characters
+			(this->offsets.capacity() + this->lengths.capacity())*sizeof(unsigned int)+ //String descriptors
+			this->copies.bucket_count()*sizeof(void*); //Buckets of the copies
+		for (Copies::const_iterator it = this->copies.begin(); it != this->copies.end(); ++it)
+			size_in_bytes += sizeof(Copies::value_type) + sizeof(void*) + it->second.value.capacity(); //Copies with their characters
+		return (unsigned int)size_in_bytes;
+	}
+
+	//the strings are written without garbage
+	template<class Archive>
+	void save(Archive & ar, const unsigned int) const
+	{
+		std::vector<char> characters;
+		characters.reserve(this->bytes.size() - this->garbage);
+		std::vector<unsigned int> string_lengths(this->size());
+		for (unsigned int i = 0; i < this->size(); i++) {
+			const StringRef value = (*this)[i];
+			characters.insert(characters.end(), value.data, value.data + value.length);
+			string_lengths[i] = value.length;
+		}
+		ar & string_lengths;
+		ar & characters;
+	}
+
+	template<class Archive>
+	void load(Archive & ar, const unsigned int)
+	{
+		this->clear();
+		ar & this->lengths;
+		ar & this->bytes;
+		this->offsets.resize(this->lengths.size());
+		unsigned int offset = 0;
+		for (unsigned int i = 0; i < this->lengths.size(); i++) {
+			this->offsets[i] = offset;
+			offset += this->lengths[i];
+		}
+	}
+	BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+private:
+	std::vector<char> bytes;
+	std::vector<unsigned int> offsets;
+	std::vector<unsigned int> lengths;
+	unsigned int garbage;
+
+	struct Copy {
+		std::string value;
+		bool writable;
+		explicit Copy(const std::string& value_) : value(value_), writable(false) {}
+	};
+	typedef boost::unordered_map<unsigned int, Copy> Copies;
+
+	Copies copies;
+	//number of writable copies, operator[] only searches the copies if there is one
+	unsigned int writable_copies;
+
+	//overwrites the characters of string i in the buffer
+	void store(unsigned int i, const StringRef& value) {
+		if (value.length <= this->lengths[i]) {
+			if (value.length > 0)
+				std::memmove(&this->bytes[this->offsets[i]], value.data, value.length);
+			this->garbage += this->lengths[i] - value.length;
+		}
+		else {
+			this->garbage += this->lengths[i];
+			this->offsets[i] = this->append(value);
+		}
+		this->lengths[i] = value.length;
+	}
+
+	void dropCopy(unsigned int i) {
+		Copies::iterator it = this->copies.find(i);
+		if (it == this->copies.end())
+			return;
+		if (it->second.writable)
+			this->writable_copies--;
+		this->copies.erase(it);
+	}
+
+	//writes the writable copies to the buffer and drops all copies
+	void storeCopies() {
+		if (this->writable_copies != 0) {
+			for (Copies::const_iterator it = this->copies.begin(); it != this->copies.end(); ++it) {
+				if (it->second.writable)
+					this->store(it->first, StringRef(it->second.value));
+			}
+		}
+		this->copies.clear();
+		this->writable_copies = 0;
+	}
+
+	//appends the characters of value to the buffer and returns their offset
+	unsigned int append(const StringRef& value) {
+		const unsigned int offset = (unsigned int)this->bytes.size();
+		if (value.length == 0)
+			return offset;
+		//value may point into the buffer itself, which is moved when it grows
+		if (!this->bytes.empty() && value.data >= &this->bytes[0] && value.data < &this->bytes[0] + this->bytes.size()) {
+			const size_t source = value.data - &this->bytes[0];
+			this->bytes.resize(this->bytes.size() + value.length);
+			std::memmove(&this->bytes[offset], &this->bytes[source], value.length);
+		}
+		else
+			this->bytes.insert(this->bytes.end(), value.data, value.data + value.length);
+		return offset;
+	}
+
+	void compactIfNeeded() {
+		if (this->garbage > 4096 && this->garbage > this->bytes.size() / 2)
+			this->compact();
+	}
+
+	//moves all strings to the front of a new buffer, the order of the strings does not change
+	void compact() {
+		std::vector<char> characters;
+		characters.reserve(this->bytes.size() - this->garbage);
+		for (unsigned int i = 0; i < this->size(); i++) {
+			const unsigned int offset = (unsigned int)characters.size();
+			characters.insert(characters.end(), this->bytes.begin() + this->offsets[i], this->bytes.begin() + this->offsets[i] + this->lengths[i]);
+			this->offsets[i] = offset;
+		}
+		this->bytes.swap(characters);
+		this->garbage = 0;
+	}
+};
+
+}; //end namespace CogaDB
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+namespace CoGaDB{
+
+/*!
+ *  \brief     A pool of worker threads, which execute the morsels of one job at a time
+ *  \details   A job consists of a number of morsels (small, independent pieces of work, e.g., a TID range of 16K rows).
+ *             The calling thread and the requested number of workers fetch the next morsel from a shared counter
+ *             until all morsels are done, so fast threads process more morsels than slow ones and no thread idles
+ *             while work is left. The threads are created once and reused by all jobs, a job only costs one
+ *             wake up per worker. Jobs of different callers are executed one after another.
+ *             A morsel must not start another job of the same pool.
+ */
+class ThreadPool{
+	public:
+	//processes the morsel with the given number
+	typedef std::function<void(unsigned int)> MorselFunction;
+
+	explicit ThreadPool(unsigned int number_of_workers);
+	~ThreadPool();
+
+	unsigned int getNumberOfWorkers() const { return (unsigned int)this->workers.size(); }
+
+	/*! \brief calls function(m) for every morsel m in [0, number_of_morsels) with at most number_of_threads threads (including the calling thread)
+	 *  \details returns after all morsels are processed*/
+	void run(unsigned int number_of_morsels, unsigned int number_of_threads, const MorselFunction& function);
+
+	/*! \brief the pool shared by all operators, it has one worker per hardware thread besides the calling thread*/
+	static ThreadPool& global();
+
+	private:
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+
+	void work();
+	void processMorsels();
+
+	std::vector<std::thread> workers;
+	//serializes the jobs of different callers
+	std::mutex job_mutex;
+	std::mutex mutex;
+	std::condition_variable job_available;
+	std::condition_variable job_finished;
+
+	//the current job
+	const MorselFunction* function;
+	unsigned int number_of_morsels;
+	std::atomic<unsigned int> next_morsel;
+	//incremented for every job, so a worker joins each job at most once
+	unsigned long generation;
+	//workers, which may still join the current job
+	unsigned int open_slots;
+	//workers, which joined the current job and did not finish yet
+	unsigned int busy_workers;
+	bool stop;
+};
+
+	inline ThreadPool::ThreadPool(unsigned int number_of_workers) : workers(), job_mutex(), mutex(), job_available(), job_finished(),
+		function(0), number_of_morsels(0), next_morsel(0), generation(0), open_slots(0), busy_workers(0), stop(false){
+		for (unsigned int i = 0; i < number_of_workers; i++)
+			this->workers.push_back(std::thread(&ThreadPool::work, this));
+	}
+
+	inline ThreadPool::~ThreadPool(){
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stop = true;
+		}
+		this->job_available.notify_all();
+		for (unsigned int i = 0; i < this->workers.size(); i++)
+			this->workers[i].join();
+	}
+
+	inline ThreadPool& ThreadPool::global(){
+		const unsigned int hardware_threads = std::thread::hardware_concurrency();
+		static ThreadPool pool(hardware_threads > 1 ? hardware_threads - 1 : 1);
+		return pool;
+	}
+
+	inline void ThreadPool::processMorsels(){
+		for (unsigned int m = this->next_morsel++; m < this->number_of_morsels; m = this->next_morsel++)
+			(*this->function)(m);
+	}
+
+	inline void ThreadPool::work(){
+		std::unique_lock<std::mutex> lock(this->mutex);
+		unsigned long last_generation = 0;
+		while (true) {
+			while (!this->stop && (this->generation == last_generation || this->open_slots == 0))
+				this->job_available.wait(lock);
+			if (this->stop)
+				return;
+			last_generation = this->generation;
+			this->open_slots--;
+			this->busy_workers++;
+
+			lock.unlock();
+			this->processMorsels();
+			lock.lock();
+
+			if (--this->busy_workers == 0)
+				this->job_finished.notify_all();
+		}
+	}
+
+	/*
+	The calling thread works on the morsels as well, so a job with one
+	thread or one morsel does not touch the workers at all.
+	*/
+	inline void ThreadPool::run(unsigned int number_of_morsels, unsigned int number_of_threads, const MorselFunction& function){
+		unsigned int helpers = 0;
+		if (number_of_threads > 1 && number_of_morsels > 1)
+			helpers = std::min(std::min(number_of_threads, number_of_morsels) - 1, this->getNumberOfWorkers());
+		if (helpers == 0) {
+			for (unsigned int m = 0; m < number_of_morsels; m++)
+				function(m);
+			return;
+		}
+
+		std::lock_guard<std::mutex> job_lock(this->job_mutex);
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->function = &function;
+			this->number_of_morsels = number_of_morsels;
+			this->next_morsel = 0;
+			this->open_slots = helpers;
+			this->generation++;
+		}
+		this->job_available.notify_all();
+
+		this->processMorsels();
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		//workers, which did not join yet, would not find any morsel
+		this->open_slots = 0;
+		while (this->busy_workers > 0)
+			this->job_finished.wait(lock);
+		this->function = 0;
+	}
+
+}; //end namespace CogaDB
@@ -8,14 +8,17 @@
 
 /*this is the include for the example compressed column with empty implementation*/
 #include <compression/dictionary_compressed_column.hpp>
+#include <compression/sorted_dictionary_compressed_column.hpp>
 #include <compression/RunLengthCompressionColumn.h>
 #include <compression/BitVectorCompression.h>
+#include <compression/binned_bitmap_column.hpp>
 
 using namespace CoGaDB;
 
 bool unittest(boost::shared_ptr<ColumnBaseTyped<int> > ptr);
 bool unittest(boost::shared_ptr<ColumnBaseTyped<float> > ptr);
 bool unittest(boost::shared_ptr<ColumnBaseTyped<std::string> > ptr);
+bool unittest_encodings();
 
 int main(){
 
@@ -73,6 +76,29 @@ int main(){
 	}
 	std::cout << "Unitests Passed!\n\n" << std::endl;
 
+	std::cout << "\n****** Sorted Dictionary Encoding ******\n\n";
+
+	boost::shared_ptr<SortedDictionaryCompressedColumn<std::string>> sorted_dict_string(new SortedDictionaryCompressedColumn<std::string>("Sorted Dictionary Compression String", VARCHAR));
+	if (!unittest(sorted_dict_string)){
+		std::cout << "At least one Unittest Failed!" << std::endl;
+		return -1;
+	}
+	std::cout << "Unitests Passed!\n\n" << std::endl;
+
+	boost::shared_ptr<SortedDictionaryCompressedColumn<float>> sorted_dict_float(new SortedDictionaryCompressedColumn<float>("Sorted Dictionary Compression Float", FLOAT));
+	if (!unittest(sorted_dict_float)){
+		std::cout << "At least one Unittest Failed!" << std::endl;
+		return -1;
+	}
+	std::cout << "Unitests Passed!\n\n" << std::endl;
+
+	boost::shared_ptr<SortedDictionaryCompressedColumn<int>> sorted_dict_int(new SortedDictionaryCompressedColumn<int>("Sorted Dictionary Compression Int", INT));
+	if (!unittest(sorted_dict_int)){
+		std::cout << "At least one Unittest Failed!" << std::endl;
+		return -1;
+	}
+	std::cout << "Unitests Passed!\n\n" << std::endl;
+
 	std::cout << "\n****** Bit Vector Encoding ******\n\n";
 	
 	boost::shared_ptr<BitVectorCompressedColumn<std::string>> vect_string(new BitVectorCompressedColumn<std::string>("Bit Vector Compression String", VARCHAR));
@@ -96,6 +122,30 @@ int main(){
 	}
 	std::cout << "Unitests Passed!\n\n" << std::endl;
 
+	std::cout << "\n****** Binned Bitmap Encoding ******\n\n";
+
+	boost::shared_ptr<BinnedBitmapColumn<float>> binned_float(new BinnedBitmapColumn<float>("Binned Bitmap Float", FLOAT));
+	if (!unittest(binned_float)){
+		std::cout << "At least one Unittest Failed!" << std::endl;
+		return -1;
+	}
+	std::cout << "Unitests Passed!\n\n" << std::endl;
+
+	boost::shared_ptr<BinnedBitmapColumn<int>> binned_int(new BinnedBitmapColumn<int>("Binned Bitmap Int", INT));
+	if (!unittest(binned_int)){
+		std::cout << "At least one Unittest Failed!" << std::endl;
+		return -1;
+	}
+	std::cout << "Unitests Passed!\n\n" << std::endl;
+
+	std::cout << "\n****** Encoding Specific Tests ******\n\n";
+
+	if (!unittest_encodings()){
+		std::cout << "At least one Unittest Failed!" << std::endl;
+		return -1;
+	}
+	std::cout << "Unitests Passed!\n\n" << std::endl;
+
 
 	//Testing was successfull
 	return 0;
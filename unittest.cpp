@@ -1,4 +1,7 @@
 #include <string>
+#include <algorithm>
+#include <map>
+#include <set>
 #include <core/global_definitions.hpp>
 #include <core/base_column.hpp>
 #include <core/column_base_typed.hpp>
@@ -6,6 +9,9 @@
 #include <core/compressed_column.hpp>
 
 #include <compression/dictionary_compressed_column.hpp>
+#include <compression/sorted_dictionary_compressed_column.hpp>
+#include <compression/RunLengthCompressionColumn.h>
+#include <compression/BitVectorCompression.h>
 
 using namespace CoGaDB;
 
@@ -64,6 +70,51 @@ bool equals(std::vector<T> reference_data, boost::shared_ptr<ColumnBaseTyped<T>
 	return true;
 }
 
+//rows of the large tests, more than a morsel, a sort chunk and a join partition, so the parallel code paths run
+const unsigned int LARGE_COLUMN_SIZE = 100000;
+//distinct values of the large tests, every value occurs about LARGE_COLUMN_SIZE / LARGE_COLUMN_DOMAIN times
+const unsigned int LARGE_COLUMN_DOMAIN = 1000;
+
+//maps a key to a value, equal keys give equal values
+template<typename T>
+T get_key_value(unsigned int key);
+
+template<>
+int get_key_value(unsigned int key) {
+	return int(key) - int(LARGE_COLUMN_DOMAIN / 2);
+}
+
+template<>
+float get_key_value(unsigned int key) {
+	return float(int(key) - int(LARGE_COLUMN_DOMAIN / 2)) / 100;
+}
+
+template<>
+std::string get_key_value(unsigned int key) {
+	std::string s = "value";
+	for (unsigned int i = 0; i < 3; i++, key /= 26)
+		s.push_back('a' + key % 26);
+	return s;
+}
+
+//returns the result pairs of a join in a canonical order
+std::vector<TID_Pair> sorted_pairs(PositionListPairPtr join_tids) {
+	std::vector<TID_Pair> pairs;
+	for (unsigned int i = 0; i < join_tids->first->size(); i++)
+		pairs.push_back(TID_Pair((*join_tids->first)[i], (*join_tids->second)[i]));
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+}
+
+//orders TIDs by their values, equal values by TID
+template<class T>
+struct ReferenceOrder {
+	const std::vector<T>& values;
+	bool descending;
+	ReferenceOrder(const std::vector<T>& values_, bool descending_) : values(values_), descending(descending_) {}
+	bool operator()(TID i, TID j) const { return descending ? values[j] < values[i] : values[i] < values[j]; }
+};
+
 template<class T>
 bool test_column(boost::shared_ptr<ColumnBaseTyped<T>> col, std::vector<T>& reference_data) {
 	/****** BASIC INSERT TEST ******/
@@ -101,6 +152,79 @@ bool test_column(boost::shared_ptr<ColumnBaseTyped<T>> col, std::vector<T>& refe
 		return false;
 	}	
 	std::cout << "SUCCESS"<< std::endl;
+	/****** DECODE TEST ******/
+	{
+		TID begin = rand() % reference_data.size();
+		TID end = begin + rand() % (reference_data.size() - begin + 1);
+		std::cout << "DECODE TEST: Decode rows [" << begin << ", " << end << ")..."; // << std::endl;
+
+		std::vector<T> decoded(end - begin + 1);
+		col->decode(begin, end, &decoded[0]);
+		if (!std::equal(reference_data.begin() + begin, reference_data.begin() + end, decoded.begin())) {
+			std::cerr << "DECODE TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SELECTION TEST ******/
+	{
+		T value = reference_data[rand() % reference_data.size()];
+		std::cout << "SELECTION TEST: Filter column by value '" << value << "'..."; // << std::endl;
+
+		ValueComparator comps[] = { EQUAL, LESSER, GREATER };
+		for (unsigned int c = 0; c < 3; c++) {
+			PositionList expected;
+			for (TID i = 0; i < reference_data.size(); i++) {
+				if ((comps[c] == EQUAL && reference_data[i] == value)
+					|| (comps[c] == LESSER && reference_data[i] < value)
+					|| (comps[c] == GREATER && reference_data[i] > value))
+					expected.push_back(i);
+			}
+			PositionListPtr result = col->selection(value, comps[c]);
+			if (!result || *result != expected) {
+				std::cerr << "SELECTION TEST FAILED!" << std::endl;
+				return false;
+			}
+			PositionListPtr parallel_result = col->parallel_selection(value, comps[c], 4);
+			if (!parallel_result || *parallel_result != expected) {
+				std::cerr << "PARALLEL SELECTION TEST FAILED!" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** JOIN TEST ******/
+	{
+		std::cout << "JOIN TEST: Join the column with its copy..."; // << std::endl;
+
+		PositionListPairPtr expected = col->nested_loop_join(copy);
+		PositionListPairPtr hash_result = col->hash_join(copy);
+		PositionListPairPtr sort_merge_result = col->sort_merge_join(copy);
+		if (!hash_result || sorted_pairs(hash_result) != sorted_pairs(expected)
+			|| !sort_merge_result || sorted_pairs(sort_merge_result) != sorted_pairs(expected)) {
+			std::cerr << "JOIN TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
+	/****** SORT TEST ******/
+	{
+		std::cout << "SORT TEST: Sort column ascending and descending..."; // << std::endl;
+
+		SortOrder orders[] = { ASCENDING, DESCENDING };
+		for (unsigned int o = 0; o < 2; o++) {
+			PositionList expected(reference_data.size());
+			for (TID i = 0; i < expected.size(); i++)
+				expected[i] = i;
+			std::stable_sort(expected.begin(), expected.end(), ReferenceOrder<T>(reference_data, orders[o] == DESCENDING));
+			PositionListPtr result = col->sort(orders[o]);
+			if (!result || *result != expected) {
+				std::cerr << "SORT TEST FAILED!" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS"<< std::endl;
+	}
 	/****** UPDATE TEST ******/
 	TID tid = rand() % 100;
 	T new_value = get_rand_value<T>();
@@ -131,6 +255,39 @@ bool test_column(boost::shared_ptr<ColumnBaseTyped<T>> col, std::vector<T>& refe
 		}
 		std::cout << "SUCCESS"<< std::endl;
 	}
+	/****** BATCH DELETE TEST ******/
+	{
+		std::cout << "BATCH DELETE TEST: Delete an unsorted list of TIDs with duplicates..."; // << std::endl;
+
+		//an empty list and a list with an invalid TID are rejected, the column stays unchanged
+		PositionListPtr invalid_tids(new PositionList());
+		if (col->remove(invalid_tids) || !equals(reference_data, col)) {
+			std::cerr << "BATCH DELETE TEST FAILED!" << std::endl;
+			return false;
+		}
+		invalid_tids->push_back(0);
+		invalid_tids->push_back(reference_data.size());
+		if (col->remove(invalid_tids) || !equals(reference_data, col)) {
+			std::cerr << "BATCH DELETE TEST FAILED!" << std::endl;
+			return false;
+		}
+
+		PositionListPtr tids(new PositionList());
+		for (unsigned int i = 0; i < 10; i++)
+			tids->push_back(rand() % reference_data.size());
+		tids->push_back(tids->front());
+		PositionList removed_tids(*tids);
+		std::sort(removed_tids.begin(), removed_tids.end());
+		removed_tids.erase(std::unique(removed_tids.begin(), removed_tids.end()), removed_tids.end());
+		for (PositionList::reverse_iterator rit = removed_tids.rbegin(); rit != removed_tids.rend(); ++rit)
+			reference_data.erase(reference_data.begin() + *rit);
+
+		if (!col->remove(tids) || reference_data.size() != col->size() || !equals(reference_data, col)) {
+			std::cerr << "BATCH DELETE TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS" << std::endl;
+	}
 	/****** STORE AND LOAD TEST ******/
 	{
 		std::cout << "STORE AND LOAD TEST: store column data on disc and load it..."; // << std::endl;
@@ -155,29 +312,421 @@ bool test_column(boost::shared_ptr<ColumnBaseTyped<T>> col, std::vector<T>& refe
 	return true;
 }
 
+//runs the operators on a column with many rows and many duplicates, the column has to be empty
+template<class T>
+bool test_large_column(boost::shared_ptr<ColumnBaseTyped<T>> col) {
+	std::cout << "LARGE COLUMN TEST: Filling column with " << LARGE_COLUMN_SIZE << " rows..."; // << std::endl;
+
+	std::vector<T> reference_data(LARGE_COLUMN_SIZE);
+	for (unsigned int i = 0; i < reference_data.size(); i++) {
+		reference_data[i] = get_key_value<T>(rand() % LARGE_COLUMN_DOMAIN);
+		col->insert(reference_data[i]);
+	}
+	if (reference_data.size() != col->size() || !equals(reference_data, col)) {
+		std::cerr << "LARGE COLUMN TEST FAILED!" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS" << std::endl;
+	/****** LARGE SELECTION TEST ******/
+	{
+		std::cout << "LARGE SELECTION TEST: Compare parallel selection and selection..."; // << std::endl;
+
+		ValueComparator comps[] = { EQUAL, LESSER, GREATER };
+		for (unsigned int v = 0; v < 3; v++) {
+			T value = reference_data[rand() % reference_data.size()];
+			for (unsigned int c = 0; c < 3; c++) {
+				PositionList expected;
+				for (TID i = 0; i < reference_data.size(); i++) {
+					if ((comps[c] == EQUAL && reference_data[i] == value)
+						|| (comps[c] == LESSER && reference_data[i] < value)
+						|| (comps[c] == GREATER && reference_data[i] > value))
+						expected.push_back(i);
+				}
+				PositionListPtr result = col->selection(value, comps[c]);
+				PositionListPtr parallel_result = col->parallel_selection(value, comps[c], 4);
+				if (!result || *result != expected || !parallel_result || *parallel_result != *result) {
+					std::cerr << "LARGE SELECTION TEST FAILED!" << std::endl;
+					return false;
+				}
+			}
+		}
+		std::cout << "SUCCESS" << std::endl;
+	}
+	/****** LARGE JOIN TEST ******/
+	{
+		std::cout << "LARGE JOIN TEST: Join the column with a small column in both directions..."; // << std::endl;
+
+		boost::shared_ptr<Column<T> > small_col(new Column<T>("small column", col->getType()));
+		std::map<T, std::vector<TID> > small_tids;
+		for (TID i = 0; i < 2 * LARGE_COLUMN_DOMAIN; i++) {
+			T value = get_key_value<T>(rand() % LARGE_COLUMN_DOMAIN);
+			small_col->insert(value);
+			small_tids[value].push_back(i);
+		}
+		std::vector<TID_Pair> expected, expected_reversed;
+		for (TID i = 0; i < reference_data.size(); i++) {
+			typename std::map<T, std::vector<TID> >::const_iterator it = small_tids.find(reference_data[i]);
+			if (it == small_tids.end())
+				continue;
+			for (unsigned int j = 0; j < it->second.size(); j++) {
+				expected.push_back(TID_Pair(i, it->second[j]));
+				expected_reversed.push_back(TID_Pair(it->second[j], i));
+			}
+		}
+		std::sort(expected.begin(), expected.end());
+		std::sort(expected_reversed.begin(), expected_reversed.end());
+
+		PositionListPairPtr hash_result = col->hash_join(small_col);
+		PositionListPairPtr sort_merge_result = col->sort_merge_join(small_col);
+		PositionListPairPtr reversed_hash_result = small_col->hash_join(col);
+		PositionListPairPtr reversed_sort_merge_result = small_col->sort_merge_join(col);
+		if (!hash_result || sorted_pairs(hash_result) != expected
+			|| !sort_merge_result || sorted_pairs(sort_merge_result) != expected
+			|| !reversed_hash_result || sorted_pairs(reversed_hash_result) != expected_reversed
+			|| !reversed_sort_merge_result || sorted_pairs(reversed_sort_merge_result) != expected_reversed) {
+			std::cerr << "LARGE JOIN TEST FAILED!" << std::endl;
+			return false;
+		}
+		std::cout << "SUCCESS" << std::endl;
+	}
+	/****** LARGE SORT TEST ******/
+	{
+		std::cout << "LARGE SORT TEST: Sort column ascending and descending, equal values keep their order..."; // << std::endl;
+
+		SortOrder orders[] = { ASCENDING, DESCENDING };
+		for (unsigned int o = 0; o < 2; o++) {
+			PositionList expected(reference_data.size());
+			for (TID i = 0; i < expected.size(); i++)
+				expected[i] = i;
+			std::stable_sort(expected.begin(), expected.end(), ReferenceOrder<T>(reference_data, orders[o] == DESCENDING));
+			PositionListPtr result = col->sort(orders[o]);
+			if (!result || *result != expected) {
+				std::cerr << "LARGE SORT TEST FAILED!" << std::endl;
+				return false;
+			}
+		}
+		std::cout << "SUCCESS" << std::endl;
+	}
+
+	return true;
+}
+
+//the arithmetic operators write every row back, the encoding has to stay consistent (e.g., its dictionary)
+bool test_arithmetic(boost::shared_ptr<ColumnBaseTyped<int>> col, std::vector<int>& reference_data) {
+	std::cout << "ARITHMETIC TEST: Add the column to itself and subtract a constant..."; // << std::endl;
+
+	ColumnPtr copy = col->copy();
+	if (!col->add(copy) || !col->minus(boost::any(1))) {
+		std::cerr << "ARITHMETIC TEST FAILED!" << std::endl;
+		return false;
+	}
+	for (unsigned int i = 0; i < reference_data.size(); i++)
+		reference_data[i] = 2 * reference_data[i] - 1;
+	if (!equals(reference_data, col)) {
+		std::cerr << "ARITHMETIC TEST FAILED!" << std::endl;
+		return false;
+	}
+	int value = reference_data[rand() % reference_data.size()];
+	PositionList expected;
+	for (TID i = 0; i < reference_data.size(); i++) {
+		if (reference_data[i] == value)
+			expected.push_back(i);
+	}
+	PositionListPtr result = col->selection(value, EQUAL);
+	if (!result || *result != expected) {
+		std::cerr << "ARITHMETIC TEST FAILED!" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS"<< std::endl;
+	return true;
+}
+
 bool unittest(boost::shared_ptr<ColumnBaseTyped<int>> col) {
 	std::cout << "RUN Unittest for Column with BaseType ColumnBaseTyped<int> >" << std::endl;
 	
+	boost::shared_ptr<ColumnBaseTyped<int>> large_col = boost::static_pointer_cast<ColumnBaseTyped<int>>(col->copy());
 	std::vector<int> reference_data(100);
 
 	fill_column(col, reference_data);
-	return test_column(col, reference_data);
+	return test_column(col, reference_data) && test_arithmetic(col, reference_data) && test_large_column(large_col);
 }
 
 bool unittest(boost::shared_ptr<ColumnBaseTyped<float>> col) {
 	std::cout << "RUN Unittest for Column with BaseType ColumnBaseTyped<float> >" << std::endl;
 
+	boost::shared_ptr<ColumnBaseTyped<float>> large_col = boost::static_pointer_cast<ColumnBaseTyped<float>>(col->copy());
 	std::vector<float> reference_data(100);
 
 	fill_column(col, reference_data);
-	return test_column(col, reference_data);
+	return test_column(col, reference_data) && test_large_column(large_col);
 }
 
 bool unittest(boost::shared_ptr<ColumnBaseTyped<std::string>> col) {
 	std::cout << "RUN Unittest for Column with BaseType ColumnBaseTyped<std::string> >" << std::endl;
 
+	boost::shared_ptr<ColumnBaseTyped<std::string>> large_col = boost::static_pointer_cast<ColumnBaseTyped<std::string>>(col->copy());
 	std::vector<std::string> reference_data(100);
 
 	fill_column(col, reference_data);
-	return test_column(col, reference_data);
-}
\ No newline at end of file
+	return test_column(col, reference_data) && test_large_column(large_col);
+}
+
+/****** ENCODING SPECIFIC TESTS ******/
+
+//checks the values and the EQUAL selection of some values, which also finds rows that were removed or overwritten incompletely
+template<class T>
+bool matches(std::vector<T>& reference_data, boost::shared_ptr<ColumnBaseTyped<T> > col) {
+	if (reference_data.size() != col->size() || !equals(reference_data, col))
+		return false;
+	for (unsigned int v = 0; v < 10 && !reference_data.empty(); v++) {
+		T value = reference_data[rand() % reference_data.size()];
+		PositionList expected;
+		for (TID i = 0; i < reference_data.size(); i++) {
+			if (reference_data[i] == value)
+				expected.push_back(i);
+		}
+		PositionListPtr result = col->selection(value, EQUAL);
+		if (!result || *result != expected)
+			return false;
+	}
+	return true;
+}
+
+//overwritten and removed values leave tombstones in the dictionary, compaction drops them once they are the majority
+template<class ColumnType>
+bool test_dictionary_compaction(boost::shared_ptr<ColumnType> col) {
+	std::cout << "DICTIONARY COMPACTION TEST: Overwrite and remove most of the distinct values of '" << col->getName() << "'..."; // << std::endl;
+
+	std::vector<int> reference_data;
+	for (int i = 0; i < 1000; i++) {
+		col->insert(i);
+		reference_data.push_back(i);
+	}
+	//the first half of the rows get 10 new values, which releases 500 values
+	for (TID i = 0; i < 500; i++) {
+		reference_data[i] = 1000 + i % 10;
+		col->update(i, boost::any(reference_data[i]));
+	}
+	for (unsigned int i = 0; i < 300; i++) {
+		TID tid = rand() % reference_data.size();
+		reference_data.erase(reference_data.begin() + tid);
+		col->remove(tid);
+	}
+	//a removed value is revived
+	reference_data.push_back(0);
+	col->insert(0);
+
+	const typename ColumnType::DictionaryPtr& dictionary = col->getDictionary();
+	const unsigned int distinct_values = std::set<int>(reference_data.begin(), reference_data.end()).size();
+	if (!matches<int>(reference_data, col)
+		|| dictionary->size() - dictionary->tombstones != distinct_values
+		|| dictionary->size() >= 1010
+		|| (dictionary->tombstones > 64 && dictionary->tombstones > dictionary->size() / 2)) {
+		std::cerr << "DICTIONARY COMPACTION TEST FAILED!" << std::endl;
+		return false;
+	}
+
+	col->compact();
+	if (!matches<int>(reference_data, col) || dictionary->tombstones != 0 || dictionary->size() != distinct_values) {
+		std::cerr << "DICTIONARY COMPACTION TEST FAILED!" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS" << std::endl;
+	return true;
+}
+
+//the columns are bound to the same dictionary, which has a live DictID for every value of the columns
+bool shared_dictionary_matches(std::vector<std::string> reference_data[2], boost::shared_ptr<DictionaryCompressedColumn<std::string> > cols[2]) {
+	std::set<std::string> distinct_values(reference_data[0].begin(), reference_data[0].end());
+	distinct_values.insert(reference_data[1].begin(), reference_data[1].end());
+	return matches<std::string>(reference_data[0], cols[0]) && matches<std::string>(reference_data[1], cols[1])
+		&& cols[0]->getDictionary() == cols[1]->getDictionary()
+		&& cols[0]->getDictionary()->size() - cols[0]->getDictionary()->tombstones == distinct_values.size();
+}
+
+//columns bound to one shared dictionary have comparable DictIDs, the dictionary counts the references of all of them
+bool test_shared_dictionary() {
+	typedef DictionaryCompressedColumn<std::string>::DictionaryPtr DictionaryPtr;
+	std::cout << "SHARED DICTIONARY TEST: Bind two columns to one dictionary..."; // << std::endl;
+
+	DictionaryPtr dictionary(new Dictionary<std::string>("Shared Dictionary String"));
+	boost::shared_ptr<DictionaryCompressedColumn<std::string> > cols[2];
+	std::vector<std::string> reference_data[2];
+	for (unsigned int c = 0; c < 2; c++) {
+		cols[c] = boost::shared_ptr<DictionaryCompressedColumn<std::string> >(new DictionaryCompressedColumn<std::string>(c == 0 ? "Shared Dictionary String A" : "Shared Dictionary String B", VARCHAR));
+		for (unsigned int i = 0; i < 200; i++) {
+			reference_data[c].push_back(get_key_value<std::string>(rand() % 50));
+			cols[c]->insert(reference_data[c].back());
+		}
+		if (!cols[c]->bindDictionary(dictionary) || cols[c]->getDictionary() != dictionary) {
+			std::cerr << "SHARED DICTIONARY TEST FAILED!" << std::endl;
+			return false;
+		}
+	}
+	//only named dictionaries can be shared, and the sorted dictionary renumbers its DictIDs
+	boost::shared_ptr<SortedDictionaryCompressedColumn<std::string> > sorted_col(new SortedDictionaryCompressedColumn<std::string>("Sorted Dictionary String", VARCHAR));
+	if (cols[0]->bindDictionary(DictionaryPtr(new Dictionary<std::string>())) || sorted_col->bindDictionary(dictionary)) {
+		std::cerr << "SHARED DICTIONARY TEST FAILED!" << std::endl;
+		return false;
+	}
+
+	//a copy shares the dictionary and releases its references when it is destroyed
+	{
+		ColumnPtr copy = cols[0]->copy();
+		if (boost::static_pointer_cast<DictionaryCompressedColumn<std::string> >(copy)->getDictionary() != dictionary) {
+			std::cerr << "SHARED DICTIONARY TEST FAILED!" << std::endl;
+			return false;
+		}
+	}
+
+	for (unsigned int i = 0; i < 100; i++) {
+		TID tid = rand() % reference_data[0].size();
+		reference_data[0].erase(reference_data[0].begin() + tid);
+		cols[0]->remove(tid);
+	}
+	for (unsigned int i = 0; i < 20; i++) {
+		TID tid = rand() % reference_data[1].size();
+		reference_data[1][tid] = get_key_value<std::string>(50 + i);
+		cols[1]->update(tid, boost::any(reference_data[1][tid]));
+	}
+
+	//hash_join compares the DictIDs, as both columns are bound to the same dictionary
+	PositionListPairPtr expected = cols[0]->nested_loop_join(cols[1]);
+	PositionListPairPtr hash_result = cols[0]->hash_join(cols[1]);
+	if (!hash_result || sorted_pairs(hash_result) != sorted_pairs(expected)) {
+		std::cerr << "SHARED DICTIONARY TEST FAILED!" << std::endl;
+		return false;
+	}
+
+	if (!shared_dictionary_matches(reference_data, cols)) {
+		std::cerr << "SHARED DICTIONARY TEST FAILED!" << std::endl;
+		return false;
+	}
+	//both columns are loaded with one dictionary object again
+	for (unsigned int c = 0; c < 2; c++) {
+		cols[c]->store("data/");
+		cols[c]->clearContent();
+	}
+	for (unsigned int c = 0; c < 2; c++)
+		cols[c]->load("data/");
+	if (!shared_dictionary_matches(reference_data, cols)) {
+		std::cerr << "SHARED DICTIONARY TEST FAILED!" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS" << std::endl;
+	return true;
+}
+
+//updates split a run and merge it with equal neighbours, removing a whole run merges its neighbours
+bool test_run_length_runs() {
+	std::cout << "RUN LENGTH RUNS TEST: Split and merge runs by updates and deletes..."; // << std::endl;
+
+	boost::shared_ptr<RunLengthCompressionColumn<int> > col(new RunLengthCompressionColumn<int>("Run Length Runs Int", INT));
+	int values[] = { 1, 1, 2, 1, 1, 3 };
+	std::vector<int> reference_data(values, values + 6);
+	for (unsigned int i = 0; i < reference_data.size(); i++)
+		col->insert(reference_data[i]);
+
+	//(1x2),(2),(1x2),(3) -> (1x4),(3)
+	reference_data.erase(reference_data.begin() + 2);
+	col->remove(2);
+	if (!matches<int>(reference_data, col) || col->getNumberOfRuns() != 2) {
+		std::cerr << "RUN LENGTH RUNS TEST FAILED!" << std::endl;
+		return false;
+	}
+
+	//(1x4),(3) -> (1),(2),(1x2),(3) -> (1x4),(3) -> (1x5) -> (2),(1x4)
+	TID tids[] = { 1, 1, 4, 0 };
+	int new_values[] = { 2, 1, 1, 2 };
+	unsigned int runs[] = { 4, 2, 1, 2 };
+	for (unsigned int i = 0; i < 4; i++) {
+		reference_data[tids[i]] = new_values[i];
+		col->update(tids[i], boost::any(new_values[i]));
+		if (!matches<int>(reference_data, col) || col->getNumberOfRuns() != runs[i]) {
+			std::cerr << "RUN LENGTH RUNS TEST FAILED!" << std::endl;
+			return false;
+		}
+	}
+
+	//unsorted TID lists with duplicates: (2),(1x4) -> (2),(1),(3),(1),(3) -> (1x5)
+	TID batch_tids[2][4] = { { 4, 2, 4, 2 }, { 4, 0, 2, 0 } };
+	int batch_values[] = { 3, 1 };
+	unsigned int batch_runs[] = { 5, 1 };
+	for (unsigned int b = 0; b < 2; b++) {
+		PositionListPtr update_tids(new PositionList(batch_tids[b], batch_tids[b] + 4));
+		for (unsigned int i = 0; i < 4; i++)
+			reference_data[batch_tids[b][i]] = batch_values[b];
+		col->update(update_tids, boost::any(batch_values[b]));
+		if (!matches<int>(reference_data, col) || col->getNumberOfRuns() != batch_runs[b]) {
+			std::cerr << "RUN LENGTH RUNS TEST FAILED!" << std::endl;
+			return false;
+		}
+	}
+	std::cout << "SUCCESS" << std::endl;
+	return true;
+}
+
+//removed rows stay hidden behind the validity bitmap, their positions are reclaimed once they are the majority
+bool test_bit_vector_compaction() {
+	std::cout << "BIT VECTOR COMPACTION TEST: Delete single rows until the column compacts itself..."; // << std::endl;
+
+	boost::shared_ptr<BitVectorCompressedColumn<int> > col(new BitVectorCompressedColumn<int>("Bit Vector Compaction Int", INT));
+	std::vector<int> reference_data;
+	for (unsigned int i = 0; i < 10000; i++) {
+		reference_data.push_back(rand() % 20);
+		col->insert(reference_data.back());
+	}
+
+	//3000 unused positions are below the threshold, inserts, updates, store and load work with the gaps
+	for (unsigned int i = 0; i < 3000; i++) {
+		TID tid = rand() % reference_data.size();
+		reference_data.erase(reference_data.begin() + tid);
+		col->remove(tid);
+	}
+	for (unsigned int i = 0; i < 100; i++) {
+		reference_data.push_back(rand() % 20);
+		col->insert(reference_data.back());
+		TID tid = rand() % reference_data.size();
+		reference_data[tid] = rand() % 20;
+		col->update(tid, boost::any(reference_data[tid]));
+	}
+	if (!matches<int>(reference_data, col) || col->getNumberOfUnusedPositions() != 3000) {
+		std::cerr << "BIT VECTOR COMPACTION TEST FAILED!" << std::endl;
+		return false;
+	}
+	col->store("data/");
+	col->clearContent();
+	col->load("data/");
+	if (!matches<int>(reference_data, col) || col->getNumberOfUnusedPositions() != 3000) {
+		std::cerr << "BIT VECTOR COMPACTION TEST FAILED!" << std::endl;
+		return false;
+	}
+
+	//more than half of the 10100 positions are unused after 2051 further deletes
+	for (unsigned int i = 0; i < 3000; i++) {
+		TID tid = rand() % reference_data.size();
+		reference_data.erase(reference_data.begin() + tid);
+		col->remove(tid);
+	}
+	if (!matches<int>(reference_data, col) || col->getNumberOfUnusedPositions() != 3000 - 2051) {
+		std::cerr << "BIT VECTOR COMPACTION TEST FAILED!" << std::endl;
+		return false;
+	}
+
+	col->compact();
+	if (!matches<int>(reference_data, col) || col->getNumberOfUnusedPositions() != 0) {
+		std::cerr << "BIT VECTOR COMPACTION TEST FAILED!" << std::endl;
+		return false;
+	}
+	std::cout << "SUCCESS" << std::endl;
+	return true;
+}
+
+bool unittest_encodings() {
+	std::cout << "RUN Unittest for the features of single encodings" << std::endl;
+
+	boost::shared_ptr<DictionaryCompressedColumn<int> > dict_int(new DictionaryCompressedColumn<int>("Dictionary Compaction Int", INT));
+	boost::shared_ptr<SortedDictionaryCompressedColumn<int> > sorted_dict_int(new SortedDictionaryCompressedColumn<int>("Sorted Dictionary Compaction Int", INT));
+	return test_dictionary_compaction(dict_int) && test_dictionary_compaction(sorted_dict_int)
+		&& test_shared_dictionary() && test_run_length_runs() && test_bit_vector_compaction();
+}